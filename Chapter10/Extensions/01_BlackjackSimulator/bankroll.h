@@ -0,0 +1,241 @@
+//Bankroll
+//Statistics over every round's net result, kept in a fixed few kilobytes however long the run
+
+#ifndef BLACKJACK_BANKROLL_H
+#define BLACKJACK_BANKROLL_H
+
+#include <cmath>
+
+//the count, mean and spread of a stream of values, updated one value at a time with Welford's
+//method, which stays accurate over billions of values where a sum of squares would not
+class RunningMoments {
+    public:
+        RunningMoments();
+        void Add(double value);
+        //combines the moments of another stream, as if its values had been added here
+        void Merge(const RunningMoments& other);
+        long long GetCount() const;
+        double GetMean() const;
+        //the sample variance, 0 with fewer than two values
+        double GetVariance() const;
+        double GetStdDev() const;
+        double GetMin() const;
+        double GetMax() const;
+    private:
+        long long m_Count;
+        double m_Mean;
+        //the sum of squared differences from the mean
+        double m_M2;
+        double m_Min;
+        double m_Max;
+};
+
+inline RunningMoments::RunningMoments(): m_Count(0), m_Mean(0.0), m_M2(0.0), m_Min(0.0), m_Max(0.0) {}
+
+inline void RunningMoments::Add(double value) {
+    ++m_Count;
+    double delta = value - m_Mean;
+    m_Mean += delta / m_Count;
+    m_M2 += delta * (value - m_Mean);
+    m_Min = (m_Count == 1 || value < m_Min) ? value : m_Min;
+    m_Max = (m_Count == 1 || value > m_Max) ? value : m_Max;
+}
+
+inline void RunningMoments::Merge(const RunningMoments& other) {
+    if (other.m_Count == 0) {
+        return;
+    }
+    if (m_Count == 0) {
+        *this = other;
+        return;
+    }
+    //Chan et al.'s pairwise update, the same result as adding the other stream value by value
+    double count = static_cast<double>(m_Count + other.m_Count);
+    double delta = other.m_Mean - m_Mean;
+    m_Mean += delta * other.m_Count / count;
+    m_M2 += other.m_M2 + delta * delta * (static_cast<double>(m_Count) * other.m_Count / count);
+    m_Count += other.m_Count;
+    m_Min = (other.m_Min < m_Min) ? other.m_Min : m_Min;
+    m_Max = (other.m_Max > m_Max) ? other.m_Max : m_Max;
+}
+
+inline long long RunningMoments::GetCount() const {
+    return m_Count;
+}
+
+inline double RunningMoments::GetMean() const {
+    return m_Mean;
+}
+
+inline double RunningMoments::GetVariance() const {
+    return (m_Count < 2) ? 0.0 : m_M2 / (m_Count - 1);
+}
+
+inline double RunningMoments::GetStdDev() const {
+    return std::sqrt(GetVariance());
+}
+
+inline double RunningMoments::GetMin() const {
+    return m_Min;
+}
+
+inline double RunningMoments::GetMax() const {
+    return m_Max;
+}
+
+//counts of round results in fixed half unit buckets. every outcome pays even money or half the
+//stake back, so a round's result is always a whole number of half units and every result within
+//+-LIMIT units has a bucket of its own: quantiles read from the buckets are exact, not estimates
+class ResultHistogram {
+    public:
+        //results beyond +-LIMIT units are counted at the edge
+        static const int LIMIT = 128;
+        static const int NUM_BUCKETS = 4 * LIMIT + 1;
+
+        ResultHistogram();
+        void Add(double result);
+        void Merge(const ResultHistogram& other);
+        long long GetCount() const;
+        //the smallest result at least the given fraction of results are no greater than
+        double GetQuantile(double fraction) const;
+        //how many results were beyond the edges, and so counted at them
+        long long GetOutOfRange() const;
+    private:
+        long long m_Buckets[NUM_BUCKETS];
+        long long m_Count;
+        long long m_OutOfRange;
+};
+
+inline ResultHistogram::ResultHistogram(): m_Count(0), m_OutOfRange(0) {
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        m_Buckets[i] = 0;
+    }
+}
+
+inline void ResultHistogram::Add(double result) {
+    //bucket i holds the result (i - 2 * LIMIT) / 2. results are whole half units, so truncating
+    //is exact, and much cheaper than rounding
+    double halves = 2.0 * result;
+    int bucket;
+    if (halves < -2 * LIMIT || halves > 2 * LIMIT) {
+        ++m_OutOfRange;
+        bucket = (halves < 0.0) ? 0 : NUM_BUCKETS - 1;
+    }
+    else {
+        bucket = static_cast<int>(halves) + 2 * LIMIT;
+    }
+    ++m_Buckets[bucket];
+    ++m_Count;
+}
+
+inline void ResultHistogram::Merge(const ResultHistogram& other) {
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        m_Buckets[i] += other.m_Buckets[i];
+    }
+    m_Count += other.m_Count;
+    m_OutOfRange += other.m_OutOfRange;
+}
+
+inline long long ResultHistogram::GetCount() const {
+    return m_Count;
+}
+
+inline double ResultHistogram::GetQuantile(double fraction) const {
+    if (m_Count == 0) {
+        return 0.0;
+    }
+    //the rank of the result wanted, counting from 1
+    double rank = std::ceil(fraction * m_Count);
+    rank = (rank < 1.0) ? 1.0 : rank;
+    long long seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        seen += m_Buckets[i];
+        if (seen >= rank) {
+            return (i - 2 * LIMIT) / 2.0;
+        }
+    }
+    return LIMIT;
+}
+
+inline long long ResultHistogram::GetOutOfRange() const {
+    return m_OutOfRange;
+}
+
+//the deepest fall of the running bankroll from a previous high. it only needs the running total
+//and its highest and lowest points, and those combine for two runs played one after the other,
+//so the trackers of separate threads merge as if each thread's rounds followed the last's
+class DrawdownTracker {
+    public:
+        DrawdownTracker();
+        void Add(double result);
+        //appends another run, whose rounds are taken to come after these
+        void Merge(const DrawdownTracker& other);
+        //the bankroll's change over the run
+        double GetTotal() const;
+        //the largest drop from a high to a later low, in units
+        double GetMaxDrawdown() const;
+        //how far the bankroll ended below its high
+        double GetCurrentDrawdown() const;
+    private:
+        double m_Total;
+        //the highest and lowest the running total reached, the start included
+        double m_Peak;
+        double m_Trough;
+        double m_MaxDrawdown;
+};
+
+inline DrawdownTracker::DrawdownTracker(): m_Total(0.0), m_Peak(0.0), m_Trough(0.0), m_MaxDrawdown(0.0) {}
+
+inline void DrawdownTracker::Add(double result) {
+    m_Total += result;
+    m_Peak = (m_Total > m_Peak) ? m_Total : m_Peak;
+    m_Trough = (m_Total < m_Trough) ? m_Total : m_Trough;
+    m_MaxDrawdown = (m_Peak - m_Total > m_MaxDrawdown) ? m_Peak - m_Total : m_MaxDrawdown;
+}
+
+inline void DrawdownTracker::Merge(const DrawdownTracker& other) {
+    //the deepest fall across the join runs from this run's high to the other's low
+    double across = m_Peak - (m_Total + other.m_Trough);
+    m_MaxDrawdown = (other.m_MaxDrawdown > m_MaxDrawdown) ? other.m_MaxDrawdown : m_MaxDrawdown;
+    m_MaxDrawdown = (across > m_MaxDrawdown) ? across : m_MaxDrawdown;
+    m_Peak = (m_Total + other.m_Peak > m_Peak) ? m_Total + other.m_Peak : m_Peak;
+    m_Trough = (m_Total + other.m_Trough < m_Trough) ? m_Total + other.m_Trough : m_Trough;
+    m_Total += other.m_Total;
+}
+
+inline double DrawdownTracker::GetTotal() const {
+    return m_Total;
+}
+
+inline double DrawdownTracker::GetMaxDrawdown() const {
+    return m_MaxDrawdown;
+}
+
+inline double DrawdownTracker::GetCurrentDrawdown() const {
+    return m_Peak - m_Total;
+}
+
+//everything kept about the net results of a run's rounds, about 4KB whatever the run's length
+struct BankrollStats {
+    RunningMoments moments;
+    ResultHistogram histogram;
+    DrawdownTracker drawdown;
+
+    //adds one round's net result for the players, in units
+    void Add(double result);
+    void Merge(const BankrollStats& other);
+};
+
+inline void BankrollStats::Add(double result) {
+    moments.Add(result);
+    histogram.Add(result);
+    drawdown.Add(result);
+}
+
+inline void BankrollStats::Merge(const BankrollStats& other) {
+    moments.Merge(other.moments);
+    histogram.Merge(other.histogram);
+    drawdown.Merge(other.drawdown);
+}
+
+#endif
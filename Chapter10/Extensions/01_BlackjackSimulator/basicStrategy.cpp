@@ -0,0 +1,91 @@
+//Basic Strategy
+//Solves the best hit/stand play for every hand, prints it as a chart and checks it in play
+//usage: basicStrategy [decks] [rounds] [h17]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "dealerOdds.h"
+#include "simulator.h"
+#include "strategy.h"
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start);
+void printChart(const BasicStrategy& strategy, bool isSoft, int lowest);
+
+int main(int argc, char* argv[]) {
+    int numDecks = (argc > 1) ? atoi(argv[1]) : 6;
+    long long rounds = (argc > 2) ? atoll(argv[2]) : 10000000;
+    bool isHittingSoft17 = (argc > 3 && string(argv[3]) == "h17");
+    if (numDecks < 1 || numDecks > Deck::MAX_DECKS || rounds < 1 || argc > 4 ||
+        (argc > 3 && !isHittingSoft17)) {
+        cerr << "usage: basicStrategy [decks 1-" << Deck::MAX_DECKS << "] [rounds] [h17]\n";
+        return 1;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    DealerOdds odds(isHittingSoft17);
+    BasicStrategy strategy;
+    strategy.Generate(numDecks, odds);
+    double generate = secondsSince(start);
+
+    cout << "Basic strategy for a " << numDecks << " deck shoe, ";
+    cout << (isHittingSoft17 ? "hitting" : "standing on") << " soft 17 (H = hit, - = stand)\n\n";
+    cout << "Hard";
+    printChart(strategy, false, 4);
+    cout << "\nSoft";
+    printChart(strategy, true, 13);
+
+    //time lookups over every hand a player can be asked about
+    const long long LOOKUPS = 100000000;
+    long long hits = 0;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < LOOKUPS; ++i) {
+        int total = 4 + static_cast<int>(i % 18);
+        int up = 1 + static_cast<int>((i >> 5) % 10);
+        hits += strategy.isHitting(total, (i & 1) != 0 && total >= 13, up);
+    }
+    double lookup = secondsSince(start);
+
+    SimConfig config;
+    config.numDecks = numDecks;
+    config.rules.isHouseHittingSoft17 = isHittingSoft17;
+    Simulator sim(strategy, config);
+    sim.Run(rounds);
+
+    cout << fixed << setprecision(3);
+    cout << "\nGenerated in " << 1e3 * generate << " ms, lookups take " << 1e9 * lookup / LOOKUPS;
+    cout << " ns (" << hits << " hits)\n";
+    cout << "House edge: " << -100.0 * strategy.GetExpectedValue() << "% expected, ";
+    cout << 100.0 * sim.GetStats().HouseEdge() << "% over " << rounds << " simulated rounds\n";
+    return 0;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void printChart(const BasicStrategy& strategy, bool isSoft, int lowest) {
+    const int UP_CARDS[] = {2, 3, 4, 5, 6, 7, 8, 9, 10, Card::ACE};
+    for (int u = 0; u < 10; ++u) {
+        if (UP_CARDS[u] == Card::ACE) {
+            cout << "\tA";
+        }
+        else {
+            cout << "\t" << UP_CARDS[u];
+        }
+    }
+    cout << "\n";
+    for (int total = lowest; total <= 21; ++total) {
+        cout << total;
+        for (int u = 0; u < 10; ++u) {
+            cout << "\t" << (strategy.isHitting(total, isSoft, UP_CARDS[u]) ? "H" : "-");
+        }
+        cout << "\n";
+    }
+}
@@ -0,0 +1,53 @@
+//Blackjack
+//The interactive Blackjack game, rebuilt on the shared rules used by the simulator
+//usage: blackjack [rules], where rules is a comma separated list such as double,split,surrender
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "console.h"
+#include "game.h"
+#include "rules.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    TableRules rules;
+    if (argc > 1 && !rules.Parse(argv[1])) {
+        cerr << "usage: blackjack [h17,double,das,split,resplit,rsa,hsa,surrender]\n";
+        return 1;
+    }
+    cout << "\t\tWelcome to Blackjack!\n\n";
+
+    int numPlayers = 0;
+    while (numPlayers < 1 || numPlayers > 7) {
+        cout << "How many players? (1 - 7): ";
+        cin >> numPlayers;
+    }
+
+    vector<Player> players;
+    players.reserve(numPlayers);
+    string name;
+    for (int i = 0; i < numPlayers; ++i) {
+        cout << "Enter player name: ";
+        cin >> name;
+        players.push_back(Player(name));
+    }
+    cout << endl;
+
+    //the game loop
+    ConsoleObserver console;
+    Game aGame(console, 1, 0.75, rules);
+    vector<Player>::iterator pPlayer;
+    for (pPlayer = players.begin(); pPlayer != players.end(); ++pPlayer) {
+        aGame.AddPlayer(&(*pPlayer));
+    }
+    char again = 'y';
+    while (again != 'n' && again != 'N') {
+        aGame.Play();
+        cout << "\nDo you want to play again? (Y/N): ";
+        cin >> again;
+    }
+    return 0;
+}
@@ -0,0 +1,712 @@
+//Blackjack Benchmarks
+//Measures the cost of the building blocks the simulator is made of
+//usage: blackjackBench [iterations]
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "../../../Common/allocationCounter.h"
+#include "../../../Common/rng.h"
+#include "bankroll.h"
+#include "console.h"
+#include "counting.h"
+#include "deck.h"
+#include "hand.h"
+#include "handBatch.h"
+#include "parallelSim.h"
+#include "policy.h"
+#include "rules.h"
+#include "simulator.h"
+#include "strategy.h"
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start);
+double percentile(vector<double> values, double fraction);
+void benchDeal(long long iterations);
+void benchTotal(long long iterations);
+void benchShuffle(long long iterations);
+void benchShoe(long long iterations);
+void benchRound(long long iterations);
+void benchThreads(long long iterations);
+bool benchPolicy(long long iterations);
+void benchCounting(long long iterations);
+void benchRender(long long iterations);
+bool benchBatch(long long iterations);
+bool benchRules(long long iterations);
+bool benchBankroll(long long iterations);
+
+int main(int argc, char* argv[]) {
+    long long iterations = (argc > 1) ? atoll(argv[1]) : 1000000;
+    if (iterations < 1) {
+        cerr << "usage: blackjackBench [iterations]\n";
+        return 1;
+    }
+    cout << "sizeof(Card) = " << sizeof(Card) << ", sizeof(Hand) = " << sizeof(Hand);
+    cout << ", sizeof(Deck) = " << sizeof(Deck) << "\n\n";
+
+    benchDeal(iterations);
+    benchTotal(iterations);
+    benchShuffle(iterations);
+    benchShoe(iterations);
+    benchRound(iterations);
+    benchThreads(iterations);
+    if (!benchPolicy(iterations)) {
+        return 1;
+    }
+    benchCounting(iterations);
+    benchRender(iterations);
+    if (!benchBatch(iterations)) {
+        return 1;
+    }
+    if (!benchRules(iterations)) {
+        return 1;
+    }
+    if (!benchBankroll(iterations)) {
+        return 1;
+    }
+    return 0;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//the value the given fraction of the way up the sorted values, 0.5 for the median; taken by
+//value because it sorts
+double percentile(vector<double> values, double fraction) {
+    sort(values.begin(), values.end());
+    return values[static_cast<size_t>(fraction * (values.size() - 1) + 0.5)];
+}
+
+//repopulates a deck and deals all of it, five cards to a hand at a time
+void benchDeal(long long iterations) {
+    Deck deck;
+    Hand hand;
+    long long dealt = 0;
+    long long allocations = g_Allocations;
+    long long bytes = g_AllocatedBytes;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations / 52 + 1; ++i) {
+        deck.Populate();
+        while (deck.size() > 0) {
+            for (int c = 0; c < 5 && deck.size() > 0; ++c) {
+                deck.Deal(hand);
+                ++dealt;
+            }
+            hand.Clear();
+        }
+    }
+    double seconds = secondsSince(start);
+    cout << "deal:  " << 1e9 * seconds / dealt << " ns/card (repopulate and shuffle included), ";
+    cout << static_cast<double>(g_Allocations - allocations) / dealt << " allocations/card, ";
+    cout << static_cast<double>(g_AllocatedBytes - bytes) / dealt << " heap bytes/card\n";
+}
+
+//asks a table of dealt hands for their totals and softness, as the hitting loops do
+void benchTotal(long long iterations) {
+    const int NUM_HANDS = 1024;
+    static Hand hands[NUM_HANDS];
+    Deck deck;
+    deck.Seed(1);
+    for (int h = 0; h < NUM_HANDS; ++h) {
+        if (deck.size() < 6) {
+            deck.Populate();
+            deck.Shuffle();
+        }
+        //two to five cards, the usual size of a hand
+        for (int c = 0; c < 2 + h % 4; ++c) {
+            deck.Deal(hands[h]);
+        }
+    }
+    long long checksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; ++i) {
+        const Hand& hand = hands[i % NUM_HANDS];
+        checksum += hand.GetTotal() + hand.isSoft();
+    }
+    double seconds = secondsSince(start);
+    cout << "total: " << 1e9 * seconds / iterations << " ns/hand (GetTotal + isSoft, checksum ";
+    cout << checksum << ")\n";
+}
+
+//a full Fisher-Yates shuffle driven by Rng::Below
+void shuffleCards(Card* cards, int numCards, Rng& rng) {
+    for (int i = numCards - 1; i > 0; --i) {
+        int j = rng.Below(i + 1);
+        Card temp = cards[i];
+        cards[i] = cards[j];
+        cards[j] = temp;
+    }
+}
+
+//full up front shuffles of a deck and of a six deck shoe, the book's way (a new random_device
+//and mt19937 every time), with one reused mt19937, and with Rng
+void benchShuffle(long long iterations) {
+    const int SIZES[] = {Deck::CARDS_PER_DECK, 6 * Deck::CARDS_PER_DECK};
+    static Card cards[6 * Deck::CARDS_PER_DECK];
+    for (int c = 0; c < 6 * Deck::CARDS_PER_DECK; ++c) {
+        cards[c] = Card(static_cast<Card::Rank>(c % 13 + 1), static_cast<Card::Suit>(c / 13 % 4));
+    }
+    long long shuffles = iterations / 50 + 1;
+    for (int s = 0; s < 2; ++s) {
+        int numCards = SIZES[s];
+        cout << "shuffle " << numCards << " cards:\n";
+
+        //the book reseeds a fresh engine on every call, so time fewer of those
+        long long bookShuffles = shuffles / 20 + 1;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long long i = 0; i < bookShuffles; ++i) {
+            random_device rd;
+            mt19937 rng(rd());
+            shuffle(cards, cards + numCards, rng);
+        }
+        cout << "       random_device + mt19937 per call: " << bookShuffles / secondsSince(start) << " shuffles/s\n";
+
+        mt19937 mt(1);
+        start = chrono::steady_clock::now();
+        for (long long i = 0; i < shuffles; ++i) {
+            shuffle(cards, cards + numCards, mt);
+        }
+        cout << "       reused mt19937:                   " << shuffles / secondsSince(start) << " shuffles/s\n";
+
+        Rng rng(1);
+        start = chrono::steady_clock::now();
+        for (long long i = 0; i < shuffles; ++i) {
+            shuffleCards(cards, numCards, rng);
+        }
+        cout << "       Rng (xoshiro256**):               " << shuffles / secondsSince(start) << " shuffles/s\n";
+    }
+}
+
+//the book's single deck, rebuilt and fully shuffled whenever fewer than 40 cards are left
+//(the Exercise 10.2 rule), kept here as the baseline the shoe is measured against
+class EagerDeck {
+    public:
+        EagerDeck(): m_NumCards(0), m_Rng(1) {}
+        void PrepareRound() {
+            if (m_NumCards < 40) {
+                m_NumCards = 0;
+                for (int s = Card::CLUBS; s <= Card::SPADES; ++s) {
+                    for (int r = Card::ACE; r <= Card::KING; ++r) {
+                        m_Cards[m_NumCards] = Card(static_cast<Card::Rank>(r), static_cast<Card::Suit>(s));
+                        ++m_NumCards;
+                    }
+                }
+                shuffle(m_Cards, m_Cards + m_NumCards, m_Rng);
+            }
+        }
+        void Deal(Hand& aHand) {
+            --m_NumCards;
+            aHand.Add(m_Cards[m_NumCards]);
+        }
+    private:
+        Card m_Cards[Deck::CARDS_PER_DECK];
+        int m_NumCards;
+        mt19937 m_Rng;
+};
+
+//deals six cards a round, about what a one player table uses, and reports the cost per round
+//of dealing plus all the shuffling the deck needed to keep up
+void benchShoe(long long iterations) {
+    const int CARDS_PER_ROUND = 6;
+    Hand hand;
+    EagerDeck eager;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; ++i) {
+        eager.PrepareRound();
+        for (int c = 0; c < CARDS_PER_ROUND; ++c) {
+            eager.Deal(hand);
+        }
+        hand.Clear();
+    }
+    cout << "shoe:  rebuild below 40, 1 deck:  " << 1e9 * secondsSince(start) / iterations << " ns/round\n";
+
+    const int DECKS[] = {1, 6, 8};
+    for (int d = 0; d < 3; ++d) {
+        Deck shoe(DECKS[d], 0.75);
+        shoe.Seed(1);
+        shoe.Shuffle();
+        start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; ++i) {
+            if (shoe.isCutCardOut()) {
+                shoe.Shuffle();
+            }
+            for (int c = 0; c < CARDS_PER_ROUND; ++c) {
+                shoe.Deal(hand);
+            }
+            hand.Clear();
+        }
+        cout << "       lazy shoe, cut at 75%, " << DECKS[d] << " deck(s): ";
+        cout << 1e9 * secondsSince(start) / iterations << " ns/round\n";
+    }
+}
+
+//plays full silent rounds with one simulated player
+void benchRound(long long iterations) {
+    SimConfig config;
+    Simulator sim(hitSimple, config);
+    sim.Run(1000);
+    long long allocations = g_Allocations;
+    long long bytes = g_AllocatedBytes;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    sim.Run(iterations);
+    double seconds = secondsSince(start);
+    cout << "round: " << 1e9 * seconds / iterations << " ns/round, ";
+    cout << static_cast<double>(g_Allocations - allocations) / iterations << " allocations/round, ";
+    cout << static_cast<double>(g_AllocatedBytes - bytes) / iterations << " heap bytes/round\n";
+}
+
+//plays the same total number of rounds on 1, 2, 4, 8 and 16 threads
+void benchThreads(long long iterations) {
+    const int THREADS[] = {1, 2, 4, 8, 16};
+    SimConfig config;
+    long long rounds = 4 * iterations;
+    double baseline = 0.0;
+    cout << "threads (" << thread::hardware_concurrency() << " hardware threads):\n";
+    for (int t = 0; t < 5; ++t) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        SimStats stats = RunParallel(hitSimple, config, rounds, THREADS[t]);
+        double roundsPerSecond = stats.rounds / secondsSince(start);
+        if (t == 0) {
+            baseline = roundsPerSecond;
+        }
+        cout << "       " << THREADS[t] << " thread(s): " << roundsPerSecond << " rounds/s (";
+        cout << roundsPerSecond / baseline << "x)\n";
+    }
+}
+
+bool sameStats(const SimStats& a, const SimStats& b) {
+    return a.rounds == b.rounds && a.hands == b.hands && a.wins == b.wins && a.losses == b.losses &&
+           a.pushes == b.pushes && a.playerBusts == b.playerBusts && a.houseBusts == b.houseBusts &&
+           a.wagered == b.wagered && a.net == b.net &&
+           a.bankroll.moments.GetMean() == b.bankroll.moments.GetMean() &&
+           a.bankroll.drawdown.GetMaxDrawdown() == b.bankroll.drawdown.GetMaxDrawdown();
+}
+
+//plays the same seeded rounds on a virtual table and a policy table, reporting the rate of each;
+//both must deal and count exactly the same, so any difference in the results is a bug
+template <typename Rule, typename Policy>
+bool comparePolicy(const char* name, const Rule& rule, const Policy& policy, int numPlayers,
+                   long long iterations) {
+    SimConfig config;
+    config.numPlayers = numPlayers;
+    Simulator virtualSim(rule, config);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    virtualSim.Run(iterations);
+    double virtualRate = iterations / secondsSince(start);
+
+    PolicySimulator<Policy> policySim(policy, config);
+    start = chrono::steady_clock::now();
+    policySim.Run(iterations);
+    double policyRate = iterations / secondsSince(start);
+
+    cout << "       " << name << ", " << numPlayers << " player(s): virtual " << virtualRate;
+    cout << " rounds/s, policy " << policyRate << " rounds/s (" << policyRate / virtualRate << "x)\n";
+    if (!sameStats(virtualSim.GetStats(), policySim.GetStats())) {
+        cout << "       results differ!\n";
+        return false;
+    }
+    return true;
+}
+
+//the same rounds played through GenericPlayer::isHitting and through a compile-time policy
+bool benchPolicy(long long iterations) {
+    BasicStrategy table;
+    DealerOdds odds;
+    table.Generate(SimConfig().numDecks, odds);
+    bool ok = true;
+    cout << "policy:\n";
+    for (int numPlayers = 1; numPlayers <= 7; numPlayers += 6) {
+        ok = comparePolicy("house ", hitLikeHouse, ThresholdPolicy<17>(), numPlayers, iterations) && ok;
+        ok = comparePolicy("simple", hitSimple, DecisionPolicy<hitSimple>(), numPlayers, iterations) && ok;
+        ok = comparePolicy("basic ", table, TablePolicy(table), numPlayers, iterations) && ok;
+    }
+    return ok;
+}
+
+//plays the same seeded rounds and returns the rate, timed in processor time rather than on the
+//wall clock so the time the machine spends on other programs isn't counted against the table
+template <typename Table, typename Rule>
+double roundsPerSecond(const Rule& rule, const SimConfig& config, long long iterations) {
+    Table sim(rule, config);
+    clock_t start = clock();
+    sim.Run(iterations);
+    return iterations / (static_cast<double>(clock() - start) / CLOCKS_PER_SEC);
+}
+
+//the cost of counting, against a policy table whose shoe keeps no count at all: first the tag
+//add on every card dealt (the same table on a counting Deck, with no system set), then each
+//system sizing every bet from the count, which also works out the betting count and ramp and
+//records every round's bet-sized result. every run times all the tables back to back, and the
+//median of the runs' ratios is reported with the middle half of them, so a slow patch on the
+//machine moves one run's ratio rather than the answer, and the spread shows how far to trust it
+void benchCounting(long long iterations) {
+    typedef DecisionPolicy<hitSimple> Policy;
+    const int RUNS = 21;
+    const int NUM_SYSTEMS = 3;
+    const CountingSystem SYSTEMS[NUM_SYSTEMS] = {CountingSystem::HiLo(), CountingSystem::KO(),
+                                                 CountingSystem::HiOptI()};
+    SimConfig config;
+    BetRamp ramp;
+    ramp.Parse("1,2,4,8,12", 1);
+    vector<double> plain;
+    //the tag add alone, then each system and ramp
+    vector<double> overheads[NUM_SYSTEMS + 1];
+    for (int run = 0; run < RUNS; ++run) {
+        double uncounted = roundsPerSecond<PolicySimulator<Policy, UncountedDeck> >(Policy(), config, iterations);
+        plain.push_back(uncounted);
+        double tagged = roundsPerSecond<PolicySimulator<Policy> >(Policy(), config, iterations);
+        overheads[0].push_back(100.0 * (uncounted / tagged - 1.0));
+        for (int s = 0; s < NUM_SYSTEMS; ++s) {
+            CountingRule<Policy> rule(Policy(), SYSTEMS[s], ramp);
+            double counted = roundsPerSecond<CountingSimulator<Policy> >(rule, config, iterations);
+            overheads[s + 1].push_back(100.0 * (uncounted / counted - 1.0));
+        }
+    }
+    cout << "count: " << RUNS << " runs of " << iterations << " rounds, median overhead against a shoe keeping no ";
+    cout << "count (middle half of runs)\n";
+    cout << "       no count:       " << percentile(plain, 0.5) << " rounds/s\n";
+    for (int s = 0; s <= NUM_SYSTEMS; ++s) {
+        string name = (s == 0) ? "tag add only" : SYSTEMS[s - 1].GetName() + " + ramp";
+        cout << "       " << name << ": " << string(14 - name.size(), ' ') << percentile(overheads[s], 0.5) << "% (";
+        cout << percentile(overheads[s], 0.25) << "% to " << percentile(overheads[s], 0.75) << "%)\n";
+    }
+}
+
+//the book's way of printing: a card builds its rank and suit string arrays every time it is
+//printed, and every line ends in std::endl, which flushes the stream
+void printBookCard(ostream& os, Card aCard) {
+    const string RANKS[] = {"0", "A", "2", "3", "4", "5", "6", "7",
+                            "8", "9", "10", "J", "Q", "K"};
+    const string SUITS[] = {"♧", "♢", "♡", "♤"};
+    if (aCard.isFaceUp()) {
+        os << RANKS[aCard.GetRank()] << SUITS[aCard.GetSuit()];
+    }
+    else {
+        os << "XX";
+    }
+}
+
+void printBookHand(ostream& os, const GenericPlayer& aGenericPlayer) {
+    os << aGenericPlayer.GetName() << ":\t";
+    for (int i = 0; i < aGenericPlayer.size(); ++i) {
+        printBookCard(os, aGenericPlayer.GetCard(i));
+        os << "\t";
+    }
+    if (aGenericPlayer.GetTotal() != 0) {
+        os << "(" << aGenericPlayer.GetTotal() << ")";
+    }
+}
+
+//prints what ConsoleObserver prints, the way the book's Game and GenericPlayer printed it
+class BookObserver : public TableObserver {
+    public:
+        BookObserver(ostream& os): m_pOs(&os) {}
+        virtual void ShowTable(const vector<GenericPlayer*>& players, const House& house) {
+            for (size_t i = 0; i < players.size(); ++i) {
+                printBookHand(*m_pOs, *players[i]);
+                *m_pOs << endl;
+            }
+            printBookHand(*m_pOs, house);
+            *m_pOs << endl;
+        }
+        virtual void StartTurn(const GenericPlayer&) {
+            *m_pOs << endl;
+        }
+        virtual void ShowHit(const GenericPlayer& aGenericPlayer) {
+            printBookHand(*m_pOs, aGenericPlayer);
+            *m_pOs << endl;
+        }
+        virtual void Bust(const GenericPlayer& aGenericPlayer) {
+            *m_pOs << aGenericPlayer.GetName() << " busts.\n";
+        }
+        virtual void RevealHouse(const House& house) {
+            *m_pOs << endl;
+            printBookHand(*m_pOs, house);
+        }
+        virtual void Win(const GenericPlayer& aPlayer) {
+            *m_pOs << aPlayer.GetName() << " wins.\n";
+        }
+        virtual void Lose(const GenericPlayer& aPlayer) {
+            if (!aPlayer.isBusted()) {
+                *m_pOs << aPlayer.GetName() << " loses.\n";
+            }
+        }
+        virtual void Push(const GenericPlayer& aPlayer) {
+            *m_pOs << aPlayer.GetName() << " pushes.\n";
+        }
+    private:
+        ostream* m_pOs;
+};
+
+//plays printed rounds to /dev/null, so the cost is the printing and the writes, not a terminal
+double renderedRoundsPerSecond(TableObserver& observer, int numPlayers, long long rounds) {
+    Game aGame(observer, 6);
+    aGame.Seed(1);
+    vector<SimPlayer> players(numPlayers, SimPlayer(hitSimple, aGame.GetHouse()));
+    for (int i = 0; i < numPlayers; ++i) {
+        aGame.AddPlayer(&players[i]);
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < rounds; ++i) {
+        aGame.Play();
+    }
+    return rounds / secondsSince(start);
+}
+
+void benchRender(long long iterations) {
+    long long rounds = iterations / 10;
+    cout << "render (to /dev/null):\n";
+    for (int numPlayers = 1; numPlayers <= 7; numPlayers += 6) {
+        ofstream book("/dev/null");
+        BookObserver bookObserver(book);
+        double bookRate = renderedRoundsPerSecond(bookObserver, numPlayers, rounds);
+
+        ofstream perEvent("/dev/null");
+        ConsoleObserver interactive(perEvent, true);
+        double eventRate = renderedRoundsPerSecond(interactive, numPlayers, rounds);
+
+        ofstream perRound("/dev/null");
+        ConsoleObserver batched(perRound, false);
+        double roundRate = renderedRoundsPerSecond(batched, numPlayers, rounds);
+
+        cout << "       " << numPlayers << " player(s): endl + string arrays " << bookRate << " rounds/s, ";
+        cout << "frame per event " << eventRate << " (" << eventRate / bookRate << "x), ";
+        cout << "frame per round " << roundRate << " (" << roundRate / bookRate << "x)\n";
+    }
+}
+
+//a hand's total worked out from its cards, the way the book's GetTotal walks them every time
+int walkTotal(const Hand& aHand, bool& isSoft) {
+    int total = 0;
+    bool hasAce = false;
+    isSoft = false;
+    for (int i = 0; i < aHand.size(); ++i) {
+        Card aCard = aHand.GetCard(i);
+        if (!aCard.isFaceUp()) {
+            return 0;
+        }
+        total += aCard.GetValue();
+        hasAce = hasAce || (aCard.GetValue() == Card::ACE);
+    }
+    if (hasAce && total <= 11) {
+        total += 10;
+        isSoft = true;
+    }
+    return total;
+}
+
+//random hands of every length a Hand can hold, some with face down cards and some made only of
+//aces and small cards to find every soft total; returns false if the batch and Hand disagree
+bool checkBatch(int numHands) {
+    Rng rng(3);
+    HandBatch batch;
+    vector<Hand> hands(numHands);
+    for (int h = 0; h < numHands; ++h) {
+        int numCards = rng.Below(Hand::MAX_CARDS + 1);
+        int maxRank = (h % 2 == 0) ? Card::KING : Card::FIVE;
+        for (int c = 0; c < numCards; ++c) {
+            Card::Rank rank = static_cast<Card::Rank>(1 + rng.Below(maxRank));
+            hands[h].Add(Card(rank, static_cast<Card::Suit>(rng.Below(4)), rng.Below(16) != 0));
+        }
+        batch.Add(hands[h]);
+    }
+    batch.Evaluate();
+    for (int h = 0; h < numHands; ++h) {
+        const Hand& aHand = hands[h];
+        if (batch.GetTotal(h) != aHand.GetTotal() || batch.isSoft(h) != aHand.isSoft() ||
+            batch.isBusted(h) != (aHand.GetTotal() > 21)) {
+            cout << "batch:  hand " << h << " evaluated to " << batch.GetTotal(h) << ", " << batch.isSoft(h);
+            cout << " but GetTotal and isSoft give " << aHand.GetTotal() << ", " << aHand.isSoft() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+//the batch against Hand's own kept totals and against walking each hand's cards, over dealt hands
+//of the usual two to five cards
+bool benchBatch(long long iterations) {
+    const int CHECKED_HANDS = 1000000;
+    if (!checkBatch(CHECKED_HANDS)) {
+        return false;
+    }
+    cout << "batch:  " << CHECKED_HANDS << " random hands match GetTotal, isSoft and busting\n";
+
+    const int NUM_HANDS = 4096;
+    vector<Hand> hands(NUM_HANDS);
+    Deck deck(6);
+    deck.Seed(1);
+    deck.Shuffle();
+    for (int h = 0; h < NUM_HANDS; ++h) {
+        if (deck.size() < 6) {
+            deck.Shuffle();
+        }
+        for (int c = 0; c < 2 + h % 4; ++c) {
+            deck.Deal(hands[h]);
+        }
+    }
+    long long passes = iterations / 100 + 1;
+    long long numEvaluated = passes * NUM_HANDS;
+
+    HandBatch batch;
+    batch.Reserve(NUM_HANDS);
+    long long loads = passes / 10 + 1;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long load = 0; load < loads; ++load) {
+        batch.Clear();
+        for (int h = 0; h < NUM_HANDS; ++h) {
+            batch.Add(hands[h]);
+        }
+    }
+    double loadSeconds = secondsSince(start);
+
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        batch.Evaluate();
+        checksum += batch.GetTotal(static_cast<int>(pass % NUM_HANDS));
+    }
+    double batchSeconds = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        for (int h = 0; h < NUM_HANDS; ++h) {
+            bool isSoft = false;
+            checksum += walkTotal(hands[h], isSoft) + isSoft;
+        }
+    }
+    double walkSeconds = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        for (int h = 0; h < NUM_HANDS; ++h) {
+            checksum += hands[h].GetTotal() + hands[h].isSoft();
+        }
+    }
+    double keptSeconds = secondsSince(start);
+
+    cout << "        " << HandBatch::LANES << " lanes: " << 1e9 * batchSeconds / numEvaluated << " ns/hand, ";
+    cout << "walking the cards " << 1e9 * walkSeconds / numEvaluated << " ns/hand (";
+    cout << walkSeconds / batchSeconds << "x), kept totals " << 1e9 * keptSeconds / numEvaluated << " ns/hand (";
+    cout << keptSeconds / batchSeconds << "x)\n";
+    cout << "        loading the batch " << 1e9 * loadSeconds / (loads * NUM_HANDS) << " ns/hand (checksum " << checksum << ")\n";
+    return true;
+}
+
+//plays full tables of playSimple players under each set of rules, with the rate, the house edge
+//and the allocations a round makes once the table is seated (none, the split hands are made when
+//a player sits down). under the book's rules playSimple must play exactly as hitSimple does
+bool benchRules(long long iterations) {
+    const char* RULES[] = {"book", "h17", "das", "split", "resplit,rsa", "surrender", "h17,das,resplit,rsa,surrender"};
+    SimConfig config;
+    config.numPlayers = 7;
+    long long rounds = iterations / 4 + 1;
+    Simulator hitting(hitSimple, config);
+    Simulator playing(playSimple, config);
+    hitting.Run(rounds);
+    playing.Run(rounds);
+    if (!sameStats(hitting.GetStats(), playing.GetStats())) {
+        cout << "rules: playSimple and hitSimple differ under the book's rules\n";
+        return false;
+    }
+    cout << "rules (7 players, playSimple):\n";
+    for (int r = 0; r < 7; ++r) {
+        config.rules = TableRules();
+        config.rules.Parse(RULES[r]);
+        Simulator sim(playSimple, config);
+        sim.Run(1000);
+        long long allocations = g_Allocations;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        sim.Run(rounds);
+        double seconds = secondsSince(start);
+        const SimStats& stats = sim.GetStats();
+        cout << "       " << RULES[r] << ": " << 1e9 * seconds / rounds << " ns/round, house edge ";
+        cout << 100.0 * stats.HouseEdge() << "%, " << static_cast<double>(stats.hands) / stats.rounds;
+        cout << " hands/round, " << static_cast<double>(g_Allocations - allocations) / rounds << " allocations/round\n";
+    }
+    return true;
+}
+
+//the streaming statistics against the same figures worked out from every result kept in memory,
+//both whole and merged from pieces the way the threads' results are, then the cost of adding one
+bool benchBankroll(long long iterations) {
+    const int NUM_RESULTS = 1000000;
+    const int NUM_PIECES = 7;
+    //results of a counter's table in half units: mostly small, with a long tail of big bets
+    Rng rng(5);
+    vector<double> results(NUM_RESULTS);
+    for (int i = 0; i < NUM_RESULTS; ++i) {
+        int bet = (rng.Below(8) == 0) ? 1 + rng.Below(12) : 1;
+        results[i] = bet * (static_cast<double>(rng.Below(9)) - 4.0) / 2.0;
+    }
+    BankrollStats whole;
+    BankrollStats pieces[NUM_PIECES];
+    for (int i = 0; i < NUM_RESULTS; ++i) {
+        whole.Add(results[i]);
+        pieces[static_cast<long long>(i) * NUM_PIECES / NUM_RESULTS].Add(results[i]);
+    }
+    BankrollStats merged;
+    for (int p = 0; p < NUM_PIECES; ++p) {
+        merged.Merge(pieces[p]);
+    }
+
+    double sum = 0.0;
+    double total = 0.0;
+    double peak = 0.0;
+    double maxDrawdown = 0.0;
+    for (int i = 0; i < NUM_RESULTS; ++i) {
+        sum += results[i];
+        total += results[i];
+        peak = max(peak, total);
+        maxDrawdown = max(maxDrawdown, peak - total);
+    }
+    double mean = sum / NUM_RESULTS;
+    double squares = 0.0;
+    for (int i = 0; i < NUM_RESULTS; ++i) {
+        squares += (results[i] - mean) * (results[i] - mean);
+    }
+    double variance = squares / (NUM_RESULTS - 1);
+    vector<double> sorted(results);
+    sort(sorted.begin(), sorted.end());
+
+    const BankrollStats* CHECKED[] = {&whole, &merged};
+    for (int c = 0; c < 2; ++c) {
+        const BankrollStats& stats = *CHECKED[c];
+        bool isRight = fabs(stats.moments.GetMean() - mean) < 1e-9 &&
+                       fabs(stats.moments.GetVariance() - variance) < 1e-9 * variance &&
+                       stats.drawdown.GetMaxDrawdown() == maxDrawdown && stats.drawdown.GetTotal() == total &&
+                       stats.moments.GetMin() == sorted.front() && stats.moments.GetMax() == sorted.back();
+        const double FRACTIONS[] = {0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999};
+        for (int q = 0; q < 7; ++q) {
+            int rank = static_cast<int>(ceil(FRACTIONS[q] * NUM_RESULTS));
+            isRight = isRight && stats.histogram.GetQuantile(FRACTIONS[q]) == sorted[rank - 1];
+        }
+        if (!isRight) {
+            cout << "bankroll: the " << (c == 0 ? "streamed" : "merged") << " statistics don't match the kept results\n";
+            return false;
+        }
+    }
+    cout << "bankroll: " << NUM_RESULTS << " results match, streamed and merged from " << NUM_PIECES;
+    cout << " pieces; sizeof(BankrollStats) = " << sizeof(BankrollStats) << "\n";
+
+    BankrollStats stats;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; ++i) {
+        stats.Add(results[i % NUM_RESULTS]);
+    }
+    double seconds = secondsSince(start);
+    cout << "          " << 1e9 * seconds / iterations << " ns/result (checksum " << stats.moments.GetMean() << ")\n";
+    return true;
+}
@@ -0,0 +1,383 @@
+//Blackjack Load
+//Plays thousands of tables against a running blackjackServer and measures how long each action
+//takes to be answered
+//usage: blackjackLoad socket [-t tables] [-c connections] [--think ms] [--seconds s] [--warmup s]
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../../Common/rng.h"
+
+using namespace std;
+
+long long nowNs();
+int connectTo(const string& path);
+bool sendAll(int fd, const string& text);
+double percentile(const vector<uint32_t>& sorted, double fraction);
+void usage();
+
+//one simulated player: the table they sit at, what they will do next and when they asked
+struct LoadTable {
+    int connection;
+    int id;
+    char action;
+    long long sentAt;
+};
+
+//a client connection carrying many tables; replies come back in the order the requests went
+struct LoadConnection {
+    int fd;
+    int firstTable;
+    string in;
+    string out;
+    bool isWriting;
+};
+
+//when a table is next due to act, earliest first
+typedef pair<long long, int> Due;
+
+class LoadGenerator {
+    public:
+        LoadGenerator(long long thinkNs);
+        //connects and opens every table; returns false if the server can't be reached
+        bool Open(const string& path, int numTables, int numConnections);
+        //plays for the given time, recording latencies once the warmup is over
+        void Run(double warmupSeconds, double seconds);
+        //the latencies recorded, in nanoseconds, sorted
+        vector<uint32_t>& GetLatencies();
+        long long GetRounds() const;
+        long long GetErrors() const;
+        double GetSeconds() const;
+    private:
+        //queues a table's next action to go after the player's thinking time
+        void Schedule(int table, char action, long long now);
+        void Send(LoadConnection& aConnection, long long now);
+        void Receive(LoadConnection& aConnection, long long now, bool isRecording);
+        //the reply "<id> <state> <total> ..." decides the table's next action
+        void Answer(LoadConnection& aConnection, const char* line, size_t length, long long now, bool isRecording);
+
+        long long m_ThinkNs;
+        Rng m_Rng;
+        int m_EpollFd;
+        vector<LoadTable> m_Tables;
+        vector<LoadConnection> m_Connections;
+        priority_queue<Due, vector<Due>, greater<Due> > m_Due;
+        vector<uint32_t> m_Latencies;
+        long long m_Rounds;
+        long long m_Errors;
+        double m_Seconds;
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    string path = argv[1];
+    int numTables = 10000;
+    int numConnections = 16;
+    double thinkMs = 100.0;
+    double seconds = 5.0;
+    double warmup = 1.0;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-t") {
+            numTables = atoi(value);
+        }
+        else if (flag == "-c") {
+            numConnections = atoi(value);
+        }
+        else if (flag == "--think") {
+            thinkMs = atof(value);
+        }
+        else if (flag == "--seconds") {
+            seconds = atof(value);
+        }
+        else if (flag == "--warmup") {
+            warmup = atof(value);
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (numTables < 1 || numConnections < 1 || numConnections > numTables || thinkMs < 0.0 ||
+        seconds <= 0.0 || warmup < 0.0) {
+        usage();
+        return 1;
+    }
+
+    LoadGenerator load(static_cast<long long>(thinkMs * 1e6));
+    if (!load.Open(path, numTables, numConnections)) {
+        cerr << "blackjackLoad: can't reach a server on " << path << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    load.Run(warmup, seconds);
+
+    vector<uint32_t>& latencies = load.GetLatencies();
+    cout << "Tables:      " << numTables << " over " << numConnections << " connection(s), ";
+    cout << thinkMs << "ms thinking time\n";
+    cout << "Actions:     " << latencies.size() << " (" << latencies.size() / load.GetSeconds() << "/s), ";
+    cout << load.GetRounds() << " rounds\n";
+    cout << "Latency:     p50 " << percentile(latencies, 0.5) / 1e3 << "us, p90 " << percentile(latencies, 0.9) / 1e3;
+    cout << "us, p99 " << percentile(latencies, 0.99) / 1e3 << "us, p99.9 " << percentile(latencies, 0.999) / 1e3;
+    cout << "us, max " << percentile(latencies, 1.0) / 1e3 << "us\n";
+    if (load.GetErrors() > 0) {
+        cout << "Errors:      " << load.GetErrors() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+long long nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int connectTo(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const string& text) {
+    size_t numSent = 0;
+    while (numSent < text.size()) {
+        ssize_t sent = send(fd, text.data() + numSent, text.size() - numSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            return false;
+        }
+        numSent += sent;
+    }
+    return true;
+}
+
+double percentile(const vector<uint32_t>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+LoadGenerator::LoadGenerator(long long thinkNs):
+    m_ThinkNs(thinkNs),
+    m_Rng(42),
+    m_EpollFd(epoll_create1(EPOLL_CLOEXEC)),
+    m_Rounds(0),
+    m_Errors(0),
+    m_Seconds(0.0)
+{}
+
+bool LoadGenerator::Open(const string& path, int numTables, int numConnections) {
+    m_Tables.resize(numTables);
+    for (int c = 0; c < numConnections; ++c) {
+        LoadConnection aConnection;
+        aConnection.fd = connectTo(path);
+        if (aConnection.fd < 0) {
+            return false;
+        }
+        aConnection.firstTable = static_cast<int>(static_cast<long long>(numTables) * c / numConnections);
+        int lastTable = static_cast<int>(static_cast<long long>(numTables) * (c + 1) / numConnections);
+        aConnection.isWriting = false;
+        //open this connection's tables a batch at a time, reading back one "open" per table
+        //before sending more, so neither side's socket buffer can fill up
+        const int BATCH = 1024;
+        for (int first = aConnection.firstTable; first < lastTable; first += BATCH) {
+            int numTables = min(BATCH, lastTable - first);
+            string requests;
+            for (int t = first; t < first + numTables; ++t) {
+                m_Tables[t].connection = c;
+                m_Tables[t].id = t - aConnection.firstTable;
+                requests += "N\n";
+            }
+            if (!sendAll(aConnection.fd, requests)) {
+                return false;
+            }
+            int numOpen = 0;
+            char buffer[16384];
+            while (numOpen < numTables) {
+                ssize_t numRead = read(aConnection.fd, buffer, sizeof(buffer));
+                if (numRead <= 0) {
+                    return false;
+                }
+                numOpen += static_cast<int>(count(buffer, buffer + numRead, '\n'));
+            }
+        }
+        //from here on the connection is only read when epoll says there is something to read
+        fcntl(aConnection.fd, F_SETFL, fcntl(aConnection.fd, F_GETFL) | O_NONBLOCK);
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = c;
+        epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, aConnection.fd, &event);
+        m_Connections.push_back(aConnection);
+    }
+    return true;
+}
+
+void LoadGenerator::Run(double warmupSeconds, double seconds) {
+    long long start = nowNs();
+    long long recordFrom = start + static_cast<long long>(warmupSeconds * 1e9);
+    long long end = recordFrom + static_cast<long long>(seconds * 1e9);
+    //tables sit down at random times over one thinking time, so they don't all act at once
+    for (size_t t = 0; t < m_Tables.size(); ++t) {
+        long long delay = (m_ThinkNs > 0) ? m_Rng.Below(static_cast<uint32_t>(min(m_ThinkNs, 4000000000LL))) : 0;
+        m_Due.push(Due(start + delay, static_cast<int>(t)));
+        m_Tables[t].action = 'D';
+    }
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    long long now = start;
+    while (now < end) {
+        //send every action that is due, then wait for replies until the next one is
+        while (!m_Due.empty() && m_Due.top().first <= now) {
+            LoadTable& aTable = m_Tables[m_Due.top().second];
+            m_Due.pop();
+            LoadConnection& aConnection = m_Connections[aTable.connection];
+            aConnection.out += aTable.action;
+            aConnection.out += ' ';
+            aConnection.out += to_string(aTable.id);
+            aConnection.out += '\n';
+            aTable.sentAt = now;
+        }
+        for (size_t c = 0; c < m_Connections.size(); ++c) {
+            if (!m_Connections[c].out.empty() && !m_Connections[c].isWriting) {
+                Send(m_Connections[c], now);
+            }
+        }
+        long long next = m_Due.empty() ? end : min(m_Due.top().first, end);
+        int timeoutMs = static_cast<int>((next - now + 999999) / 1000000);
+        int numEvents = epoll_wait(m_EpollFd, events, MAX_EVENTS, max(timeoutMs, 0));
+        now = nowNs();
+        for (int i = 0; i < numEvents; ++i) {
+            LoadConnection& aConnection = m_Connections[events[i].data.u32];
+            if (events[i].events & EPOLLOUT) {
+                Send(aConnection, now);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                Receive(aConnection, now, now >= recordFrom);
+            }
+        }
+    }
+    m_Seconds = static_cast<double>(now - recordFrom) / 1e9;
+    sort(m_Latencies.begin(), m_Latencies.end());
+}
+
+void LoadGenerator::Schedule(int table, char action, long long now) {
+    //thinking time varies from half to one and a half times the average
+    long long think = m_ThinkNs / 2 + (m_ThinkNs > 0 ? m_Rng.Below(static_cast<uint32_t>(min(m_ThinkNs, 4000000000LL))) : 0);
+    m_Tables[table].action = action;
+    m_Due.push(Due(now + think, table));
+}
+
+void LoadGenerator::Send(LoadConnection& aConnection, long long) {
+    ssize_t numSent = send(aConnection.fd, aConnection.out.data(), aConnection.out.size(), MSG_NOSIGNAL);
+    if (numSent > 0) {
+        aConnection.out.erase(0, numSent);
+    }
+    bool isWriting = !aConnection.out.empty();
+    if (isWriting != aConnection.isWriting) {
+        epoll_event event;
+        event.events = isWriting ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        event.data.u32 = static_cast<uint32_t>(&aConnection - &m_Connections[0]);
+        epoll_ctl(m_EpollFd, EPOLL_CTL_MOD, aConnection.fd, &event);
+        aConnection.isWriting = isWriting;
+    }
+}
+
+void LoadGenerator::Receive(LoadConnection& aConnection, long long now, bool isRecording) {
+    char buffer[65536];
+    ssize_t numRead = read(aConnection.fd, buffer, sizeof(buffer));
+    if (numRead <= 0) {
+        if (numRead == 0 || errno != EAGAIN) {
+            ++m_Errors;
+            epoll_ctl(m_EpollFd, EPOLL_CTL_DEL, aConnection.fd, 0);
+        }
+        return;
+    }
+    aConnection.in.append(buffer, numRead);
+    size_t start = 0;
+    size_t end = aConnection.in.find('\n');
+    while (end != string::npos) {
+        Answer(aConnection, aConnection.in.data() + start, end - start, now, isRecording);
+        start = end + 1;
+        end = aConnection.in.find('\n', start);
+    }
+    aConnection.in.erase(0, start);
+}
+
+void LoadGenerator::Answer(LoadConnection& aConnection, const char* line, size_t length, long long now,
+                           bool isRecording) {
+    //"<id> <state> <total> ...", read in place
+    const char* lineEnd = line + length;
+    const char* state = static_cast<const char*>(memchr(line, ' ', length));
+    const char* total = (state == 0) ? 0 : static_cast<const char*>(memchr(state + 1, ' ', lineEnd - state - 1));
+    if (total == 0 || line[0] < '0' || line[0] > '9' || strncmp(state + 1, "error", 5) == 0) {
+        ++m_Errors;
+        return;
+    }
+    int table = aConnection.firstTable + atoi(line);
+    if (isRecording) {
+        long long latency = now - m_Tables[table].sentAt;
+        m_Latencies.push_back(static_cast<uint32_t>(min(latency, 4000000000LL)));
+    }
+    if (total - state == 5 && strncmp(state + 1, "play", 4) == 0) {
+        //the player hits like the house does, below 17
+        Schedule(table, atoi(total + 1) < 17 ? 'H' : 'S', now);
+    }
+    else {
+        m_Rounds += isRecording;
+        Schedule(table, 'D', now);
+    }
+}
+
+vector<uint32_t>& LoadGenerator::GetLatencies() {
+    return m_Latencies;
+}
+
+long long LoadGenerator::GetRounds() const {
+    return m_Rounds;
+}
+
+long long LoadGenerator::GetErrors() const {
+    return m_Errors;
+}
+
+double LoadGenerator::GetSeconds() const {
+    return m_Seconds;
+}
+
+void usage() {
+    cerr << "usage: blackjackLoad socket [-t tables] [-c connections] [--think ms] [--seconds s] [--warmup s]\n";
+}
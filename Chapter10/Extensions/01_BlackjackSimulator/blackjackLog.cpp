@@ -0,0 +1,261 @@
+//Blackjack Log
+//Records simulated rounds to a binary log, and replays logged rounds exactly as they were played
+//usage: blackjackLog record file [-n rounds] [-p players] [-s house|never|simple|basic] [-d decks]
+//                               [--penetration fraction] [--seed seed]
+//       blackjackLog replay file round
+//       blackjackLog verify file
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "console.h"
+#include "dealerOdds.h"
+#include "game.h"
+#include "roundLog.h"
+#include "simulator.h"
+#include "strategy.h"
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start);
+HitDecision decisionFromName(const string& name);
+int record(int argc, char* argv[]);
+int replay(const string& path, long long round);
+int verify(const string& path);
+void usage();
+
+int main(int argc, char* argv[]) {
+    string mode = (argc > 1) ? argv[1] : "";
+    if (mode == "record" && argc >= 3) {
+        return record(argc, argv);
+    }
+    if (mode == "replay" && argc == 4) {
+        return replay(argv[2], atoll(argv[3]));
+    }
+    if (mode == "verify" && argc == 3) {
+        return verify(argv[2]);
+    }
+    usage();
+    return 1;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+HitDecision decisionFromName(const string& name) {
+    if (name == "house") {
+        return hitLikeHouse;
+    }
+    if (name == "never") {
+        return hitNever;
+    }
+    if (name == "simple") {
+        return hitSimple;
+    }
+    return 0;
+}
+
+//a silent table of simulated players, which can be played with or without a recorder watching
+class LoggedTable {
+    public:
+        LoggedTable(const string& strategy, const BasicStrategy& table, const LogHeader& header,
+                    LogWriter* pWriter);
+        ~LoggedTable();
+        void Run(long long rounds);
+        const SimStats& GetStats() const;
+    private:
+        CountingObserver m_Counts;
+        RoundRecorder m_Recorder;
+        Game m_Game;
+        vector<GenericPlayer*> m_Players;
+};
+
+LoggedTable::LoggedTable(const string& strategy, const BasicStrategy& table, const LogHeader& header,
+                         LogWriter* pWriter):
+    m_Recorder(m_Counts, pWriter),
+    //with no writer the recorder is left out altogether, so the table plays at its usual speed
+    m_Game(pWriter != 0 ? static_cast<TableObserver&>(m_Recorder) : m_Counts, header.numDecks, header.penetration)
+{
+    m_Game.Seed(header.seed, header.stream);
+    for (int i = 0; i < header.numPlayers; ++i) {
+        if (strategy == "basic") {
+            m_Players.push_back(new StrategyPlayer(table, m_Game.GetHouse()));
+        }
+        else {
+            m_Players.push_back(new SimPlayer(decisionFromName(strategy), m_Game.GetHouse()));
+        }
+        m_Game.AddPlayer(m_Players.back());
+    }
+}
+
+LoggedTable::~LoggedTable() {
+    vector<GenericPlayer*>::iterator pPlayer;
+    for (pPlayer = m_Players.begin(); pPlayer != m_Players.end(); ++pPlayer) {
+        delete *pPlayer;
+        *pPlayer = 0;
+    }
+}
+
+void LoggedTable::Run(long long rounds) {
+    for (long long i = 0; i < rounds; ++i) {
+        m_Game.Play();
+    }
+}
+
+const SimStats& LoggedTable::GetStats() const {
+    return m_Counts.GetStats();
+}
+
+int record(int argc, char* argv[]) {
+    string path = argv[2];
+    long long rounds = 1000000;
+    string strategy = "simple";
+    LogHeader header;
+    header.numDecks = 6;
+    header.seed = random_device()();
+    for (int i = 3; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-n") {
+            rounds = atoll(value);
+        }
+        else if (flag == "-p") {
+            header.numPlayers = atoi(value);
+        }
+        else if (flag == "-s") {
+            strategy = value;
+        }
+        else if (flag == "-d") {
+            header.numDecks = atoi(value);
+        }
+        else if (flag == "--penetration") {
+            header.penetration = atof(value);
+        }
+        else if (flag == "--seed") {
+            header.seed = strtoull(value, 0, 10);
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (rounds < 1 || header.numPlayers < 1 || header.numPlayers > 7 || header.numDecks < 1 ||
+        header.numDecks > Deck::MAX_DECKS || header.penetration <= 0.0 || header.penetration > 1.0 ||
+        (decisionFromName(strategy) == 0 && strategy != "basic")) {
+        usage();
+        return 1;
+    }
+    BasicStrategy table;
+    if (strategy == "basic") {
+        DealerOdds odds;
+        table.Generate(header.numDecks, odds);
+    }
+
+    //the same rounds played twice, first with nothing watching and then recorded, to see what
+    //recording costs and to check that it doesn't change a single round
+    LoggedTable plain(strategy, table, header, 0);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    plain.Run(rounds);
+    double plainSeconds = secondsSince(start);
+
+    LogWriter writer;
+    if (!writer.Open(path, header)) {
+        cerr << "blackjackLog: can't create " << path << "\n";
+        return 1;
+    }
+    LoggedTable logged(strategy, table, header, &writer);
+    start = chrono::steady_clock::now();
+    logged.Run(rounds);
+    bool written = writer.Close();
+    double loggedSeconds = secondsSince(start);
+    if (!written) {
+        cerr << "blackjackLog: writing " << path << " failed\n";
+        return 1;
+    }
+
+    long long bytes = writer.GetBytesWritten();
+    cout << "Logged:      " << rounds << " rounds to " << path << " (seed " << header.seed << ")\n";
+    cout << "Size:        " << bytes << " bytes (" << static_cast<double>(bytes - LogHeader::SIZE) / rounds;
+    cout << " per round)\n";
+    cout << "Unlogged:    " << rounds / plainSeconds << " rounds/s\n";
+    cout << "Logged:      " << rounds / loggedSeconds << " rounds/s, " << bytes / loggedSeconds / 1e6 << " MB/s\n";
+    const SimStats& a = plain.GetStats();
+    const SimStats& b = logged.GetStats();
+    if (a.wins != b.wins || a.losses != b.losses || a.pushes != b.pushes || a.houseBusts != b.houseBusts) {
+        cout << "Recording changed the rounds played!\n";
+        return 1;
+    }
+    return 0;
+}
+
+int replay(const string& path, long long round) {
+    LogReader reader;
+    if (!reader.Open(path)) {
+        cerr << "blackjackLog: " << path << " isn't a readable log\n";
+        return 1;
+    }
+    if (round < 0 || round >= reader.size()) {
+        cerr << "blackjackLog: the log has rounds 0 to " << reader.size() - 1 << "\n";
+        return 1;
+    }
+    const LogHeader& header = reader.GetHeader();
+    cout << "Round " << round << " of " << reader.size() << " (seed " << header.seed << ", stream ";
+    cout << header.stream << ", " << header.numDecks << " deck(s), " << header.numPlayers << " player(s))\n\n";
+
+    ConsoleObserver console;
+    RoundReplayer replayer(header, console);
+    int size = 0;
+    const unsigned char* bytes = reader.GetRound(round, size);
+    if (!replayer.Replay(bytes, size)) {
+        cout << "\nThe replay does not match the log!\n";
+        return 1;
+    }
+    cout << "\nReplayed exactly as logged\n";
+    return 0;
+}
+
+int verify(const string& path) {
+    LogReader reader;
+    if (!reader.Open(path)) {
+        cerr << "blackjackLog: " << path << " isn't a readable log\n";
+        return 1;
+    }
+    TableObserver silent;
+    RoundReplayer replayer(reader.GetHeader(), silent);
+    long long mismatches = 0;
+    long long firstMismatch = -1;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long i = 0; i < reader.size(); ++i) {
+        int size = 0;
+        const unsigned char* bytes = reader.GetRound(i, size);
+        if (!replayer.Replay(bytes, size)) {
+            firstMismatch = (mismatches == 0) ? i : firstMismatch;
+            ++mismatches;
+        }
+    }
+    double seconds = secondsSince(start);
+    cout << "Replayed:    " << reader.size() << " rounds (" << reader.size() / seconds << " rounds/s)\n";
+    cout << "Mismatches:  " << mismatches;
+    if (mismatches > 0) {
+        cout << " (first at round " << firstMismatch << ")";
+    }
+    cout << "\n";
+    return (mismatches == 0) ? 0 : 1;
+}
+
+void usage() {
+    cerr << "usage: blackjackLog record file [-n rounds] [-p players 1-7] [-s house|never|simple|basic]\n";
+    cerr << "                               [-d decks 1-" << Deck::MAX_DECKS << "] [--penetration fraction] [--seed seed]\n";
+    cerr << "       blackjackLog replay file round\n";
+    cerr << "       blackjackLog verify file\n";
+}
@@ -0,0 +1,92 @@
+//Blackjack Server
+//Serves any number of Blackjack tables over a Unix domain socket until interrupted
+//usage: blackjackServer socket [-w workers] [-d decks] [--penetration fraction] [--seed seed]
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+#include "deck.h"
+#include "tableServer.h"
+
+using namespace std;
+
+void usage();
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    ServerConfig config;
+    config.path = argv[1];
+    config.numWorkers = static_cast<int>(thread::hardware_concurrency());
+    config.numWorkers = (config.numWorkers > 0) ? config.numWorkers : 1;
+    config.seed = random_device()();
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-w") {
+            config.numWorkers = atoi(value);
+        }
+        else if (flag == "-d") {
+            config.numDecks = atoi(value);
+        }
+        else if (flag == "--penetration") {
+            config.penetration = atof(value);
+        }
+        else if (flag == "--seed") {
+            config.seed = strtoull(value, 0, 10);
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (config.numWorkers < 1 || config.numDecks < 1 || config.numDecks > Deck::MAX_DECKS ||
+        config.penetration <= 0.0 || config.penetration > 1.0) {
+        usage();
+        return 1;
+    }
+
+    //the workers inherit a mask blocking the shutdown signals, so only the main thread, waiting
+    //for them below, ever sees them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, 0);
+
+    TableServer server(config);
+    if (!server.Listen()) {
+        cerr << "blackjackServer: can't listen on " << config.path << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    cout << "Serving tables on " << config.path << " with " << config.numWorkers << " worker(s) (seed ";
+    cout << config.seed << ")" << endl;
+    thread workers(&TableServer::Run, &server);
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.Stop();
+    workers.join();
+
+    cout << "Connections: " << server.GetConnections() << "\n";
+    cout << "Tables:      " << server.GetTables() << "\n";
+    cout << "Requests:    " << server.GetRequests() << "\n";
+    return 0;
+}
+
+void usage() {
+    cerr << "usage: blackjackServer socket [-w workers] [-d decks 1-" << Deck::MAX_DECKS << "]";
+    cerr << " [--penetration fraction] [--seed seed]\n";
+}
@@ -0,0 +1,254 @@
+//Blackjack Simulator
+//Plays Blackjack rounds headlessly and reports win/loss/push counts, the house edge and the spread
+//and drawdown of the table's results, or with
+//-c, counts cards and bets by the count, reporting EV, variance and risk of ruin
+//usage: blackjackSim [-n rounds] [-p players] [-s house|never|simple|basic] [-d decks]
+//                    [--penetration fraction] [--seed seed] [-t threads] [--table policy|virtual]
+//                    [-c hilo|ko|hiopt1] [--ramp bets] [--ramp-start count] [--bankroll units]
+//                    [--rules h17,double,das,split,resplit,rsa,hsa,surrender]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "bankroll.h"
+#include "counting.h"
+#include "dealerOdds.h"
+#include "parallelSim.h"
+#include "rules.h"
+#include "simulator.h"
+#include "strategy.h"
+
+using namespace std;
+
+HitDecision decisionFromName(const string& name);
+SimStats runPolicy(const string& strategy, const BasicStrategy& table, const SimConfig& config,
+                   long long rounds, int numThreads);
+CountStats runCounting(const string& strategy, const BasicStrategy& table, const CountingSystem& system,
+                       const BetRamp& ramp, const SimConfig& config, long long rounds, int numThreads);
+void printBankroll(const BankrollStats& bankroll);
+void printCounting(const CountStats& stats, const CountingSystem& system, const BetRamp& ramp, double bankroll);
+void usage();
+
+int main(int argc, char* argv[]) {
+    long long rounds = 1000000;
+    string strategy = "simple";
+    string tableKind = "policy";
+    string countName;
+    string rampBets = "1,2,4,8,12";
+    int rampStart = 1;
+    double bankroll = 1000.0;
+    SimConfig config;
+    config.seed = random_device()();
+    int numThreads = thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-n") {
+            rounds = atoll(value);
+        }
+        else if (flag == "-p") {
+            config.numPlayers = atoi(value);
+        }
+        else if (flag == "-s") {
+            strategy = value;
+        }
+        else if (flag == "-d") {
+            config.numDecks = atoi(value);
+        }
+        else if (flag == "--penetration") {
+            config.penetration = atof(value);
+        }
+        else if (flag == "--seed") {
+            config.seed = strtoul(value, 0, 10);
+        }
+        else if (flag == "-t") {
+            numThreads = atoi(value);
+        }
+        else if (flag == "--table") {
+            tableKind = value;
+        }
+        else if (flag == "-c") {
+            countName = value;
+        }
+        else if (flag == "--ramp") {
+            rampBets = value;
+        }
+        else if (flag == "--ramp-start") {
+            rampStart = atoi(value);
+        }
+        else if (flag == "--bankroll") {
+            bankroll = atof(value);
+        }
+        else if (flag == "--rules") {
+            if (!config.rules.Parse(value)) {
+                usage();
+                return 1;
+            }
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    HitDecision decide = decisionFromName(strategy);
+    bool useTable = (strategy == "basic");
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    if (rounds < 1 || config.numPlayers < 1 || config.numPlayers > 7 ||
+        config.numDecks < 1 || config.numDecks > Deck::MAX_DECKS || (decide == 0 && !useTable) ||
+        (tableKind != "policy" && tableKind != "virtual")) {
+        usage();
+        return 1;
+    }
+    //the policy tables only play the book's rules, so any others are played at virtual tables;
+    //there the simple strategy also doubles, splits and surrenders where the rules allow
+    bool isBookRules = config.rules.isBookRules();
+    if (!isBookRules) {
+        tableKind = "virtual";
+    }
+    //counting is only done on the policy tables
+    bool counting = !countName.empty();
+    CountingSystem system = CountingSystem::HiLo();
+    BetRamp ramp;
+    if (counting && (!CountingSystem::FromName(countName, system) || !ramp.Parse(rampBets, rampStart) ||
+                     tableKind != "policy" || !isBookRules)) {
+        usage();
+        return 1;
+    }
+
+    //the basic strategy table is solved for the shoe being dealt from and the house's soft 17 rule
+    BasicStrategy table;
+    if (useTable) {
+        DealerOdds odds(config.rules.isHouseHittingSoft17);
+        table.Generate(config.numDecks, odds);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    CountStats countStats;
+    SimStats stats;
+    if (counting) {
+        countStats = runCounting(strategy, table, system, ramp, config, rounds, numThreads);
+        stats = countStats.outcomes;
+    }
+    else if (!isBookRules && strategy == "simple") {
+        stats = RunParallel(playSimple, config, rounds, numThreads);
+    }
+    else if (tableKind == "virtual") {
+        stats = useTable ? RunParallel(table, config, rounds, numThreads)
+                         : RunParallel(decide, config, rounds, numThreads);
+    }
+    else {
+        stats = runPolicy(strategy, table, config, rounds, numThreads);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << "Strategy:    " << strategy << " (seed " << config.seed << ")\n";
+    cout << "Threads:     " << numThreads << " (" << tableKind << " tables)\n";
+    cout << "Shoe:        " << config.numDecks << " deck(s), cut at " << 100.0 * config.penetration << "%\n";
+    cout << "Rounds:      " << stats.rounds << " (" << stats.hands << " hands)\n";
+    cout << "Wins:        " << stats.wins << "\n";
+    cout << "Losses:      " << stats.losses << " (" << stats.playerBusts << " busts)\n";
+    cout << "Pushes:      " << stats.pushes << "\n";
+    cout << "House busts: " << stats.houseBusts << "\n";
+    if (isBookRules) {
+        cout << "House edge:  " << 100.0 * stats.HouseEdge() << "% (flat bets)\n";
+    }
+    else {
+        cout << "Rules:       " << config.rules.GetNames() << "\n";
+        cout << "Doubles:     " << stats.doubles << ", splits " << stats.splits << ", surrenders ";
+        cout << stats.surrenders << "\n";
+        cout << "House edge:  " << 100.0 * stats.HouseEdge() << "% (of " << stats.wagered << " units wagered)\n";
+    }
+    //a counter's rounds are at the bets the ramp made
+    printBankroll(counting ? countStats.bankroll : stats.bankroll);
+    if (counting) {
+        printCounting(countStats, system, ramp, bankroll);
+    }
+    cout << "Time:        " << elapsed.count() << "s (" << stats.rounds / elapsed.count() << " rounds/s)\n";
+    return 0;
+}
+
+HitDecision decisionFromName(const string& name) {
+    if (name == "house") {
+        return hitLikeHouse;
+    }
+    if (name == "never") {
+        return hitNever;
+    }
+    if (name == "simple") {
+        return hitSimple;
+    }
+    return 0;
+}
+
+//every strategy name gets its own instantiation, so the choice is made once here and not per hand
+SimStats runPolicy(const string& strategy, const BasicStrategy& table, const SimConfig& config,
+                   long long rounds, int numThreads) {
+    if (strategy == "house") {
+        return RunParallelPolicy(ThresholdPolicy<17>(), config, rounds, numThreads);
+    }
+    if (strategy == "never") {
+        return RunParallelPolicy(DecisionPolicy<hitNever>(), config, rounds, numThreads);
+    }
+    if (strategy == "simple") {
+        return RunParallelPolicy(DecisionPolicy<hitSimple>(), config, rounds, numThreads);
+    }
+    return RunParallelPolicy(TablePolicy(table), config, rounds, numThreads);
+}
+
+CountStats runCounting(const string& strategy, const BasicStrategy& table, const CountingSystem& system,
+                       const BetRamp& ramp, const SimConfig& config, long long rounds, int numThreads) {
+    if (strategy == "house") {
+        CountingRule<ThresholdPolicy<17> > rule(ThresholdPolicy<17>(), system, ramp);
+        return RunParallelCounting(rule, config, rounds, numThreads);
+    }
+    if (strategy == "never") {
+        CountingRule<DecisionPolicy<hitNever> > rule(DecisionPolicy<hitNever>(), system, ramp);
+        return RunParallelCounting(rule, config, rounds, numThreads);
+    }
+    if (strategy == "simple") {
+        CountingRule<DecisionPolicy<hitSimple> > rule(DecisionPolicy<hitSimple>(), system, ramp);
+        return RunParallelCounting(rule, config, rounds, numThreads);
+    }
+    CountingRule<TablePolicy> rule(TablePolicy(table), system, ramp);
+    return RunParallelCounting(rule, config, rounds, numThreads);
+}
+
+void printBankroll(const BankrollStats& bankroll) {
+    cout << "Per round:   " << bankroll.moments.GetMean() << " units (sd " << bankroll.moments.GetStdDev();
+    cout << ", " << bankroll.moments.GetMin() << " to " << bankroll.moments.GetMax() << ")\n";
+    cout << "Percentiles: 1% " << bankroll.histogram.GetQuantile(0.01) << ", 50% " << bankroll.histogram.GetQuantile(0.5);
+    cout << ", 99% " << bankroll.histogram.GetQuantile(0.99) << " units\n";
+    cout << "Drawdown:    " << bankroll.drawdown.GetMaxDrawdown() << " units at most, ";
+    cout << bankroll.drawdown.GetCurrentDrawdown() << " below the high at the end\n";
+}
+
+void printCounting(const CountStats& stats, const CountingSystem& system, const BetRamp& ramp, double bankroll) {
+    cout << "Count:       " << system.GetName() << (system.isBalanced() ? " (true count)" : " (running count)");
+    cout << ", bets " << ramp.GetMinBet() << "-" << ramp.GetMaxBet() << " units\n";
+    cout << "Wagered:     " << stats.wagered << " units (" << static_cast<double>(stats.wagered) / stats.outcomes.rounds;
+    cout << " per round)\n";
+    cout << "EV:          " << stats.ExpectedValue() << " units/round (" << 100.0 * stats.Edge() << "% of wagers)\n";
+    cout << "Variance:    " << stats.Variance() << " units^2/round (sd " << sqrt(stats.Variance()) << ")\n";
+    cout << "Risk of ruin: " << 100.0 * stats.RiskOfRuin(bankroll) << "% with " << bankroll << " units\n";
+}
+
+void usage() {
+    cerr << "usage: blackjackSim [-n rounds] [-p players 1-7] [-s house|never|simple|basic]\n";
+    cerr << "                    [-d decks 1-" << Deck::MAX_DECKS << "] [--penetration fraction] [--seed seed]\n";
+    cerr << "                    [-t threads] [--table policy|virtual]\n";
+    cerr << "                    [-c hilo|ko|hiopt1] [--ramp bets,...] [--ramp-start count] [--bankroll units]\n";
+    cerr << "                    [--rules h17,double,das,split,resplit,rsa,hsa,surrender]\n";
+}
@@ -0,0 +1,101 @@
+//Card
+//A Blackjack playing card, shared by the interactive game and the headless simulator
+
+#ifndef BLACKJACK_CARD_H
+#define BLACKJACK_CARD_H
+
+#include <ostream>
+#include <string>
+
+//a card is a single byte: bits 0-3 hold the rank, bits 4-5 the suit and bit 6 is set when face up,
+//so copying a card is as cheap as copying a char
+class Card {
+    public:
+        enum Rank {ACE = 1, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING};
+        enum Suit {CLUBS, DIAMOND, HEARTS, SPADES};
+
+        //overloading << operator so can send Card object to standard output
+        friend std::ostream& operator<<(std::ostream& os, const Card& aCard);
+
+        Card(Rank r = ACE, Suit s = SPADES, bool isFaceUp = true);
+
+        //returns the value of a card, 1-11
+        int GetValue() const;
+        Rank GetRank() const;
+        Suit GetSuit() const;
+        bool isFaceUp() const;
+
+        //flips a card; if face up, becomes face down and vice-versa
+        void Flip();
+        //the card as it is printed, such as "10♡", or "XX" while face down
+        const std::string& GetText() const;
+    private:
+        static const unsigned char RANK_MASK = 0x0F;
+        static const unsigned char SUIT_SHIFT = 4;
+        static const unsigned char SUIT_MASK = 0x30;
+        static const unsigned char FACE_UP_SHIFT = 6;
+        static const unsigned char FACE_UP = 1 << FACE_UP_SHIFT;
+
+        unsigned char m_Bits;
+};
+
+static_assert(sizeof(Card) == 1, "a Card should pack into a single byte");
+
+inline Card::Card(Rank r, Suit s, bool isFaceUp):
+    m_Bits(static_cast<unsigned char>(r | (s << SUIT_SHIFT) | (isFaceUp ? FACE_UP : 0)))
+{}
+
+inline int Card::GetValue() const {
+    //value is number showing on card, 10 for face cards; looked up rather than compared, so
+    //dealing never branches on which card came out
+    static const unsigned char VALUES[RANK_MASK + 1] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 0, 0};
+    //if a cards is face down, its value is 0
+    return VALUES[GetRank()] * ((m_Bits & FACE_UP) >> FACE_UP_SHIFT);
+}
+
+inline Card::Rank Card::GetRank() const {
+    return static_cast<Rank>(m_Bits & RANK_MASK);
+}
+
+inline Card::Suit Card::GetSuit() const {
+    return static_cast<Suit>((m_Bits & SUIT_MASK) >> SUIT_SHIFT);
+}
+
+inline bool Card::isFaceUp() const {
+    return (m_Bits & FACE_UP) != 0;
+}
+
+inline void Card::Flip() {
+    m_Bits ^= FACE_UP;
+}
+
+inline const std::string& Card::GetText() const {
+    //the text of every rank and suit pairing is built the first time any card is printed and
+    //kept, indexed by the card's rank and suit bits, so printing a card never builds a string
+    static const struct CardTexts {
+        std::string text[(SUIT_MASK | RANK_MASK) + 1];
+        std::string faceDown;
+        CardTexts(): faceDown("XX") {
+            const char* RANKS[] = {"0", "A", "2", "3", "4", "5", "6", "7",
+                                   "8", "9", "10", "J", "Q", "K"};
+            const char* SUITS[] = {"♧", "♢", "♡", "♤"};
+            for (int s = CLUBS; s <= SPADES; ++s) {
+                for (int r = ACE; r <= KING; ++r) {
+                    text[(s << SUIT_SHIFT) | r] = std::string(RANKS[r]) + SUITS[s];
+                }
+            }
+        }
+    } TEXTS;
+    if (!isFaceUp()) {
+        return TEXTS.faceDown;
+    }
+    return TEXTS.text[m_Bits & (SUIT_MASK | RANK_MASK)];
+}
+
+//overloads << operator so Card object can be sent to cout
+inline std::ostream& operator<<(std::ostream& os, const Card& aCard) {
+    os << aCard.GetText();
+    return os;
+}
+
+#endif
@@ -0,0 +1,193 @@
+//Console
+//The human player and the console view used by the interactive game
+
+#ifndef BLACKJACK_CONSOLE_H
+#define BLACKJACK_CONSOLE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "game.h"
+#include "hand.h"
+#include "render.h"
+
+class Player : public GenericPlayer {
+    public:
+        Player(const std::string& name = "");
+        virtual ~Player();
+        //returns whether or not the player wants another hit
+        virtual bool isHitting() const;
+        //asks for any of the allowed decisions, or just whether to hit when that's all there is
+        virtual Decision Decide(const Hand& aHand, unsigned int allowed) const;
+};
+
+inline Player::Player(const std::string& name): GenericPlayer(name) {}
+
+inline Player::~Player() {}
+
+inline bool Player::isHitting() const {
+    std::cout << m_Name << ", do you want a hit> (Y/N): ";
+    char response;
+    std::cin >> response;
+    return (response == 'y' || response == 'Y');
+}
+
+inline GenericPlayer::Decision Player::Decide(const Hand& aHand, unsigned int allowed) const {
+    //the player's own hand with only a hit to decide on gets the original question
+    if (&aHand == this && (allowed & ~((1u << HIT) | (1u << STAND))) == 0) {
+        return GenericPlayer::Decide(aHand, allowed);
+    }
+    //the letter that picks each decision, in Decision order
+    static const char KEYS[] = "SHDPR";
+    static const char* const NAMES[] = {"(S)tand", "(H)it", "(D)ouble", "s(P)lit", "su(R)render"};
+    while (true) {
+        std::cout << m_Name << ", you have " << aHand.GetTotal() << ",";
+        for (int decision = STAND; decision <= SURRENDER; ++decision) {
+            if (allowed & (1u << decision)) {
+                std::cout << " " << NAMES[decision];
+            }
+        }
+        std::cout << "> ";
+        char response;
+        if (!(std::cin >> response)) {
+            return STAND;
+        }
+        response = static_cast<char>((response >= 'a' && response <= 'z') ? response - 'a' + 'A' : response);
+        for (int decision = STAND; decision <= SURRENDER; ++decision) {
+            if (KEYS[decision] == response && (allowed & (1u << decision))) {
+                return static_cast<Decision>(decision);
+            }
+        }
+    }
+}
+
+//prints the table exactly as the original Blackjack program did. each event is a frame, built
+//by a TableRenderer and written in one go; an interactive table writes each frame as it happens,
+//so it is on screen before the next prompt, otherwise a whole round is kept as one frame and
+//written once its last result is in
+class ConsoleObserver : public TableObserver {
+    public:
+        ConsoleObserver(std::ostream& os = std::cout, bool isInteractive = true);
+        virtual void Reshuffle();
+        virtual void ShowTable(const std::vector<GenericPlayer*>& players, const House& house);
+        virtual void StartTurn(const GenericPlayer& aGenericPlayer);
+        virtual void ShowHit(const GenericPlayer& aGenericPlayer);
+        virtual void Bust(const GenericPlayer& aGenericPlayer);
+        virtual void DoubleDown(const GenericPlayer& aHand);
+        virtual void Split(const GenericPlayer& aHand, const GenericPlayer& newHand);
+        virtual void Surrender(const GenericPlayer& aHand);
+        virtual void RevealHouse(const House& house);
+        virtual void Win(const GenericPlayer& aPlayer);
+        virtual void Lose(const GenericPlayer& aPlayer);
+        virtual void Push(const GenericPlayer& aPlayer);
+        virtual void EndRound();
+    private:
+        //the end of an event: written straight away at an interactive table
+        void EndFrame();
+
+        TableRenderer m_Renderer;
+        bool m_isInteractive;
+};
+
+inline ConsoleObserver::ConsoleObserver(std::ostream& os, bool isInteractive):
+    m_Renderer(os),
+    m_isInteractive(isInteractive)
+{}
+
+inline void ConsoleObserver::EndFrame() {
+    if (m_isInteractive) {
+        m_Renderer.Write();
+    }
+}
+
+inline void ConsoleObserver::EndRound() {
+    if (!m_isInteractive) {
+        m_Renderer.Write();
+    }
+}
+
+inline void ConsoleObserver::Reshuffle() {
+    m_Renderer.AddText("Shuffling the shoe\n");
+    EndFrame();
+}
+
+inline void ConsoleObserver::ShowTable(const std::vector<GenericPlayer*>& players, const House& house) {
+    //display everyone's hand
+    std::vector<GenericPlayer*>::const_iterator pPlayer;
+    for (pPlayer = players.begin(); pPlayer != players.end(); ++pPlayer) {
+        m_Renderer.AddHand(*(*pPlayer));
+        m_Renderer.NewLine();
+    }
+    m_Renderer.AddHand(house);
+    m_Renderer.NewLine();
+    EndFrame();
+}
+
+inline void ConsoleObserver::StartTurn(const GenericPlayer&) {
+    m_Renderer.NewLine();
+    EndFrame();
+}
+
+inline void ConsoleObserver::ShowHit(const GenericPlayer& aGenericPlayer) {
+    m_Renderer.AddHand(aGenericPlayer);
+    m_Renderer.NewLine();
+    EndFrame();
+}
+
+inline void ConsoleObserver::Bust(const GenericPlayer& aGenericPlayer) {
+    m_Renderer.AddText(aGenericPlayer.GetName());
+    m_Renderer.AddText(" busts.\n");
+    EndFrame();
+}
+
+inline void ConsoleObserver::DoubleDown(const GenericPlayer& aHand) {
+    m_Renderer.AddText(aHand.GetName());
+    m_Renderer.AddText(" doubles down.\n");
+    EndFrame();
+}
+
+inline void ConsoleObserver::Split(const GenericPlayer& aHand, const GenericPlayer& newHand) {
+    m_Renderer.AddText(aHand.GetName());
+    m_Renderer.AddText(" splits.\n");
+    m_Renderer.AddHand(aHand);
+    m_Renderer.NewLine();
+    m_Renderer.AddHand(newHand);
+    m_Renderer.NewLine();
+    EndFrame();
+}
+
+inline void ConsoleObserver::Surrender(const GenericPlayer& aHand) {
+    m_Renderer.AddText(aHand.GetName());
+    m_Renderer.AddText(" surrenders.\n");
+    EndFrame();
+}
+
+inline void ConsoleObserver::RevealHouse(const House& house) {
+    m_Renderer.NewLine();
+    m_Renderer.AddHand(house);
+    EndFrame();
+}
+
+inline void ConsoleObserver::Win(const GenericPlayer& aPlayer) {
+    m_Renderer.AddText(aPlayer.GetName());
+    m_Renderer.AddText(" wins.\n");
+    EndFrame();
+}
+
+inline void ConsoleObserver::Lose(const GenericPlayer& aPlayer) {
+    //a busted player has already been told so
+    if (!aPlayer.isBusted()) {
+        m_Renderer.AddText(aPlayer.GetName());
+        m_Renderer.AddText(" loses.\n");
+    }
+    EndFrame();
+}
+
+inline void ConsoleObserver::Push(const GenericPlayer& aPlayer) {
+    m_Renderer.AddText(aPlayer.GetName());
+    m_Renderer.AddText(" pushes.\n");
+    EndFrame();
+}
+
+#endif
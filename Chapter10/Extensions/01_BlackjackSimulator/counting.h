@@ -0,0 +1,333 @@
+//Counting
+//Card counting systems, a bet ramp driven by the count, and a simulated table that bets with them
+
+#ifndef BLACKJACK_COUNTING_H
+#define BLACKJACK_COUNTING_H
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "bankroll.h"
+#include "deck.h"
+#include "policy.h"
+#include "simulator.h"
+
+//a card counting system: the tag every card adds to the running count, the count a fresh shoe
+//starts at and whether the tags sum to zero over a deck (a balanced count)
+class CountingSystem {
+    public:
+        //the tag for each card value, ace (1) to ten (10); tagsByValue[0] is unused
+        CountingSystem(const std::string& name, const int tagsByValue[ShoeCounts::NUM_VALUES],
+                       bool isBalanced, int initialCount = 0, int initialPerDeck = 0);
+        //2-6 count +1, 10s and aces -1
+        static CountingSystem HiLo();
+        //Knock-Out: 2-7 count +1, 10s and aces -1, starting at 4 - 4 per deck
+        static CountingSystem KO();
+        //Hi-Opt I: 3-6 count +1, 10s -1, aces are left out
+        static CountingSystem HiOptI();
+        //looks up a system by its command line name (hilo, ko or hiopt1), returns false if unknown
+        static bool FromName(const std::string& name, CountingSystem& system);
+
+        const std::string& GetName() const;
+        bool isBalanced() const;
+        //sets the deck's tags so it keeps this system's running count as it deals
+        void Apply(Deck& aDeck) const;
+        //the count a bet is sized on: the true count (running count per deck left, rounded down)
+        //for a balanced system, and the running count itself for an unbalanced one, which is
+        //designed to be bet on directly
+        int GetBettingCount(const Deck& aDeck) const;
+    private:
+        static const int RECIPROCAL_BITS = 24;
+        //1 / decks left in fixed point, for every number of cards a shoe can have left, rounded
+        //up ([0]) and down ([1])
+        struct ReciprocalTable {
+            static const int MAX_CARDS = Deck::MAX_DECKS * Deck::CARDS_PER_DECK;
+            int reciprocal[2][MAX_CARDS + 1];
+            ReciprocalTable();
+        };
+        static const ReciprocalTable& GetReciprocals();
+
+        std::string m_Name;
+        int m_Tags[Deck::NUM_RANKS];
+        bool m_isBalanced;
+        int m_InitialCount;
+        int m_InitialPerDeck;
+};
+
+inline CountingSystem::CountingSystem(const std::string& name, const int tagsByValue[ShoeCounts::NUM_VALUES],
+                                      bool isBalanced, int initialCount, int initialPerDeck):
+    m_Name(name),
+    m_isBalanced(isBalanced),
+    m_InitialCount(initialCount),
+    m_InitialPerDeck(initialPerDeck)
+{
+    //the deck looks tags up by rank, so copy each value's tag to every rank of that value
+    m_Tags[0] = 0;
+    for (int r = Card::ACE; r < Deck::NUM_RANKS; ++r) {
+        m_Tags[r] = tagsByValue[r < 10 ? r : 10];
+    }
+}
+
+inline CountingSystem CountingSystem::HiLo() {
+    //                                        -   A  2  3  4  5  6  7  8  9  10
+    const int TAGS[ShoeCounts::NUM_VALUES] = {0, -1, 1, 1, 1, 1, 1, 0, 0, 0, -1};
+    return CountingSystem("hilo", TAGS, true);
+}
+
+inline CountingSystem CountingSystem::KO() {
+    const int TAGS[ShoeCounts::NUM_VALUES] = {0, -1, 1, 1, 1, 1, 1, 1, 0, 0, -1};
+    return CountingSystem("ko", TAGS, false, 4, -4);
+}
+
+inline CountingSystem CountingSystem::HiOptI() {
+    const int TAGS[ShoeCounts::NUM_VALUES] = {0, 0, 0, 1, 1, 1, 1, 0, 0, 0, -1};
+    return CountingSystem("hiopt1", TAGS, true);
+}
+
+inline bool CountingSystem::FromName(const std::string& name, CountingSystem& system) {
+    if (name == "hilo") {
+        system = HiLo();
+    }
+    else if (name == "ko") {
+        system = KO();
+    }
+    else if (name == "hiopt1") {
+        system = HiOptI();
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+inline const std::string& CountingSystem::GetName() const {
+    return m_Name;
+}
+
+inline bool CountingSystem::isBalanced() const {
+    return m_isBalanced;
+}
+
+inline void CountingSystem::Apply(Deck& aDeck) const {
+    aDeck.SetCountTags(m_Tags, m_InitialCount + m_InitialPerDeck * aDeck.GetNumDecks());
+}
+
+inline int CountingSystem::GetBettingCount(const Deck& aDeck) const {
+    int runningCount = aDeck.GetRunningCount();
+    if (!m_isBalanced) {
+        return runningCount;
+    }
+    //dividing by the decks left is a multiply by a looked up reciprocal and a shift, which rounds
+    //down; the reciprocal is rounded up for a positive count and down for a negative one so that
+    //its error never carries the result past a whole number
+    const ReciprocalTable& table = GetReciprocals();
+    long long scaled = static_cast<long long>(runningCount) * table.reciprocal[runningCount < 0][aDeck.size()];
+    return static_cast<int>(scaled >> RECIPROCAL_BITS);
+}
+
+inline CountingSystem::ReciprocalTable::ReciprocalTable() {
+    reciprocal[0][0] = 0;
+    reciprocal[1][0] = 0;
+    for (int n = 1; n <= MAX_CARDS; ++n) {
+        long long numerator = static_cast<long long>(Deck::CARDS_PER_DECK) << RECIPROCAL_BITS;
+        reciprocal[0][n] = static_cast<int>((numerator + n - 1) / n);
+        reciprocal[1][n] = static_cast<int>(numerator / n);
+    }
+}
+
+inline const CountingSystem::ReciprocalTable& CountingSystem::GetReciprocals() {
+    //built once, the first time any system asks for it
+    static const ReciprocalTable TABLE;
+    return TABLE;
+}
+
+//how many units to bet at each count: bets[0] at firstCount or below, bets[i] at firstCount + i
+//and the last bet at every count above that
+class BetRamp {
+    public:
+        static const int MAX_STEPS = 16;
+
+        //a flat bet of one unit
+        BetRamp();
+        //reads a comma separated list of bets, such as "1,2,4,8"; returns false (leaving the
+        //ramp unchanged) if the list is empty, too long or has a bet below 1
+        bool Parse(const std::string& bets, int firstCount);
+        //the bet for a round played at the given count
+        int GetBet(int count) const;
+        int GetMinBet() const;
+        int GetMaxBet() const;
+    private:
+        int m_Bets[MAX_STEPS];
+        int m_NumSteps;
+        int m_FirstCount;
+};
+
+inline BetRamp::BetRamp(): m_NumSteps(1), m_FirstCount(0) {
+    m_Bets[0] = 1;
+}
+
+inline bool BetRamp::Parse(const std::string& bets, int firstCount) {
+    int parsed[MAX_STEPS];
+    int numSteps = 0;
+    const char* p = bets.c_str();
+    while (*p != '\0') {
+        char* end = 0;
+        long bet = std::strtol(p, &end, 10);
+        if (end == p || bet < 1 || numSteps == MAX_STEPS || (*end != ',' && *end != '\0')) {
+            return false;
+        }
+        parsed[numSteps] = static_cast<int>(bet);
+        ++numSteps;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    if (numSteps == 0) {
+        return false;
+    }
+    for (int i = 0; i < numSteps; ++i) {
+        m_Bets[i] = parsed[i];
+    }
+    m_NumSteps = numSteps;
+    m_FirstCount = firstCount;
+    return true;
+}
+
+inline int BetRamp::GetBet(int count) const {
+    //clamp the step into the table; the compiler turns both into conditional moves, not branches
+    int step = count - m_FirstCount;
+    step = (step < 0) ? 0 : step;
+    step = (step < m_NumSteps - 1) ? step : m_NumSteps - 1;
+    return m_Bets[step];
+}
+
+inline int BetRamp::GetMinBet() const {
+    return m_Bets[0];
+}
+
+inline int BetRamp::GetMaxBet() const {
+    return m_Bets[m_NumSteps - 1];
+}
+
+//what a counter's bets won: the outcome counts plus the money, in betting units, per round
+struct CountStats {
+    SimStats outcomes;
+    //total units bet over every hand
+    long long wagered;
+    //units won by the players
+    long long net;
+    //every round's result at the bets the ramp made, which the per round figures come from
+    BankrollStats bankroll;
+
+    CountStats();
+    //adds another run's counts to these
+    void Merge(const CountStats& other);
+    //expected units won per round, the mean of bankroll's moments
+    double ExpectedValue() const;
+    //variance of the units won in a round, from bankroll's moments
+    double Variance() const;
+    //units won per unit wagered, the player's edge (negative while the house has the edge)
+    double Edge() const;
+    //the chance of ever losing a bankroll of the given number of units, using the standard
+    //diffusion approximation exp(-2 * EV * bankroll / variance); 1 when the EV is not positive
+    double RiskOfRuin(double bankroll) const;
+};
+
+inline CountStats::CountStats(): wagered(0), net(0) {}
+
+inline void CountStats::Merge(const CountStats& other) {
+    outcomes.Merge(other.outcomes);
+    wagered += other.wagered;
+    net += other.net;
+    bankroll.Merge(other.bankroll);
+}
+
+inline double CountStats::ExpectedValue() const {
+    return bankroll.moments.GetMean();
+}
+
+inline double CountStats::Variance() const {
+    return bankroll.moments.GetVariance();
+}
+
+inline double CountStats::Edge() const {
+    if (wagered == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(net) / wagered;
+}
+
+inline double CountStats::RiskOfRuin(double bankroll) const {
+    double ev = ExpectedValue();
+    double variance = Variance();
+    if (ev <= 0.0 || variance <= 0.0) {
+        return 1.0;
+    }
+    return std::exp(-2.0 * ev * bankroll / variance);
+}
+
+//everything a counting table is set up with besides the SimConfig
+template <typename Policy>
+struct CountingRule {
+    Policy policy;
+    CountingSystem system;
+    BetRamp ramp;
+
+    CountingRule(const Policy& aPolicy, const CountingSystem& aSystem, const BetRamp& aRamp);
+};
+
+template <typename Policy>
+inline CountingRule<Policy>::CountingRule(const Policy& aPolicy, const CountingSystem& aSystem, const BetRamp& aRamp):
+    policy(aPolicy),
+    system(aSystem),
+    ramp(aRamp)
+{}
+
+//a PolicySimulator whose players size every bet from the count the shoe has kept while dealing;
+//every seat bets the same, as if one counter were playing them all
+template <typename Policy>
+class CountingSimulator {
+    public:
+        typedef CountStats Stats;
+
+        CountingSimulator(const CountingRule<Policy>& rule, const SimConfig& config);
+        //plays the given number of rounds
+        void Run(long long rounds);
+        const CountStats& GetStats() const;
+    private:
+        PolicySimulator<Policy> m_Table;
+        CountingSystem m_System;
+        BetRamp m_Ramp;
+        int m_NumSeats;
+        CountStats m_Stats;
+};
+
+template <typename Policy>
+inline CountingSimulator<Policy>::CountingSimulator(const CountingRule<Policy>& rule, const SimConfig& config):
+    m_Table(rule.policy, config),
+    m_System(rule.system),
+    m_Ramp(rule.ramp),
+    m_NumSeats(config.numPlayers < PolicySimulator<Policy>::MAX_SEATS ? config.numPlayers
+                                                                      : PolicySimulator<Policy>::MAX_SEATS)
+{
+    m_System.Apply(m_Table.GetDeck());
+}
+
+template <typename Policy>
+inline void CountingSimulator<Policy>::Run(long long rounds) {
+    for (long long i = 0; i < rounds; ++i) {
+        //the bet goes down before the cards come out, on the count the previous rounds left
+        int bet = m_Ramp.GetBet(m_System.GetBettingCount(m_Table.GetDeck()));
+        long long net = static_cast<long long>(bet) * m_Table.PlayRound();
+        m_Stats.wagered += bet * m_NumSeats;
+        m_Stats.net += net;
+        m_Stats.bankroll.Add(static_cast<double>(net));
+    }
+    m_Stats.outcomes = m_Table.GetStats();
+}
+
+template <typename Policy>
+inline const CountStats& CountingSimulator<Policy>::GetStats() const {
+    return m_Stats;
+}
+
+#endif
@@ -0,0 +1,122 @@
+//Dealer Odds
+//Prints the exact distribution of the house's final total for every up card, and checks the
+//calculator against the house playing real hands from a real shoe
+//usage: dealerOdds [decks] [samples] [h17]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "dealerOdds.h"
+#include "deck.h"
+#include "hand.h"
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start);
+void printOutcome(const DealerOutcome& outcome);
+
+int main(int argc, char* argv[]) {
+    int numDecks = (argc > 1) ? atoi(argv[1]) : 6;
+    long long samples = (argc > 2) ? atoll(argv[2]) : 2000000;
+    bool isHittingSoft17 = (argc > 3 && string(argv[3]) == "h17");
+    if (numDecks < 1 || numDecks > Deck::MAX_DECKS || samples < 1 || argc > 4 ||
+        (argc > 3 && !isHittingSoft17)) {
+        cerr << "usage: dealerOdds [decks 1-" << Deck::MAX_DECKS << "] [samples] [h17]\n";
+        return 1;
+    }
+
+    DealerOdds odds(isHittingSoft17);
+    ShoeCounts full = ShoeCounts::Full(numDecks);
+    cout << fixed << setprecision(4);
+    cout << "House final totals from a fresh " << numDecks << " deck shoe, ";
+    cout << (isHittingSoft17 ? "hitting" : "standing on") << " soft 17\n\n";
+    cout << "Up\t17\t18\t19\t20\t21\tBust\n";
+    const int UP_CARDS[] = {2, 3, 4, 5, 6, 7, 8, 9, 10, Card::ACE};
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int u = 0; u < 10; ++u) {
+        ShoeCounts shoe = full;
+        shoe.Remove(UP_CARDS[u]);
+        DealerOutcome outcome = odds.FromUpCard(shoe, UP_CARDS[u]);
+        if (UP_CARDS[u] == Card::ACE) {
+            cout << "A";
+        }
+        else {
+            cout << UP_CARDS[u];
+        }
+        printOutcome(outcome);
+    }
+    double cold = secondsSince(start);
+
+    //the same ten queries again, answered from the memo
+    start = chrono::steady_clock::now();
+    double checksum = 0.0;
+    const int REPEATS = 1000;
+    for (int r = 0; r < REPEATS; ++r) {
+        for (int u = 0; u < 10; ++u) {
+            ShoeCounts shoe = full;
+            shoe.Remove(UP_CARDS[u]);
+            checksum += odds.FromUpCard(shoe, UP_CARDS[u]).Bust();
+        }
+    }
+    double warm = secondsSince(start) / REPEATS;
+    cout << "\nAll ten up cards: " << 1e6 * cold << " us from scratch (" << odds.GetMemoSize();
+    cout << " states memoized), " << 1e6 * warm << " us from the memo\n";
+
+    //check against the house itself: deal it two cards from a freshly shuffled shoe and let it
+    //hit by its own rule, then compare with the calculator started from an empty hand
+    DealerOutcome exact = odds.FromHand(full, 0, false);
+    long long tally[DealerOutcome::NUM_RESULTS] = {0};
+    Deck deck(numDecks, 1.0);
+    deck.Seed(1);
+    House house;
+    house.SetHittingSoft17(isHittingSoft17);
+    for (long long i = 0; i < samples; ++i) {
+        deck.Shuffle();
+        house.Clear();
+        deck.Deal(house);
+        deck.Deal(house);
+        while (!house.isBusted() && house.isHitting()) {
+            deck.Deal(house);
+        }
+        if (house.isBusted()) {
+            ++tally[DealerOutcome::BUST];
+        }
+        else {
+            ++tally[house.GetTotal() - 17];
+        }
+    }
+    cout << "\nAny up card\t17\t18\t19\t20\t21\tBust\n";
+    cout << "Exact      ";
+    printOutcome(exact);
+    cout << "Dealt      ";
+    double worst = 0.0;
+    for (int r = 0; r < DealerOutcome::NUM_RESULTS; ++r) {
+        double p = static_cast<double>(tally[r]) / samples;
+        cout << "\t" << p;
+        //how many standard errors the sample is from the exact answer
+        double error = sqrt(exact.probability[r] * (1.0 - exact.probability[r]) / samples);
+        double z = fabs(p - exact.probability[r]) / error;
+        if (z > worst) {
+            worst = z;
+        }
+    }
+    cout << "\n\nLargest difference: " << setprecision(2) << worst << " standard errors over ";
+    cout << samples << " dealt hands\n";
+    return (worst < 5.0) ? 0 : 1;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void printOutcome(const DealerOutcome& outcome) {
+    for (int r = 0; r < DealerOutcome::NUM_RESULTS; ++r) {
+        cout << "\t" << outcome.probability[r];
+    }
+    cout << "\n";
+}
@@ -0,0 +1,160 @@
+//Dealer Odds
+//The exact distribution of the house's final total for a given shoe
+
+#ifndef BLACKJACK_DEALER_ODDS_H
+#define BLACKJACK_DEALER_ODDS_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "deck.h"
+
+//where the house's hand can finish; the house stands on 17 or more, except a soft 17 under H17
+struct DealerOutcome {
+    enum Result {SEVENTEEN, EIGHTEEN, NINETEEN, TWENTY, TWENTY_ONE, BUST, NUM_RESULTS};
+
+    double probability[NUM_RESULTS];
+
+    DealerOutcome();
+    //probability the house finishes on the given total (17-21)
+    double Total(int total) const;
+    double Bust() const;
+};
+
+inline DealerOutcome::DealerOutcome() {
+    for (int r = 0; r < NUM_RESULTS; ++r) {
+        probability[r] = 0.0;
+    }
+}
+
+inline double DealerOutcome::Total(int total) const {
+    return probability[total - 17];
+}
+
+inline double DealerOutcome::Bust() const {
+    return probability[BUST];
+}
+
+//plays out every card sequence the house could draw, following House::isHitting (hit on 16 or
+//less, and on a soft 17 too under H17), weighting each by its chance of coming out of the
+//given shoe. a house hand that is still drawing is summed up by its hard total and whether it holds an ace;
+//together with what is left in the shoe that decides everything that can follow, so results
+//are memoized on (shoe, hard total, ace). the memo is kept between calls, so later queries
+//against similar shoes reuse the earlier work
+class DealerOdds {
+    public:
+        //the house stands on every 17 unless isHittingSoft17 (H17) is set; the memo only holds
+        //answers for the one rule, so a table with the other rule needs its own DealerOdds
+        DealerOdds(bool isHittingSoft17 = false);
+        bool isHittingSoft17() const;
+        //distribution of the house's final total when it shows upCardValue (1 for an ace) and
+        //draws its hole card and any hits from the shoe; the shoe must not include the up card
+        DealerOutcome FromUpCard(const ShoeCounts& shoe, int upCardValue);
+        //distribution of the final total of a house hand that has already been dealt some cards
+        DealerOutcome FromHand(const ShoeCounts& shoe, int hardTotal, bool hasAce);
+        //number of distinct house states solved so far
+        int GetMemoSize() const;
+        void ClearMemo();
+    private:
+        struct StateHash {
+            std::size_t operator()(const std::pair<std::uint64_t, std::uint32_t>& key) const;
+        };
+        typedef std::pair<std::uint64_t, std::uint32_t> StateKey;
+
+        DealerOutcome Expand(ShoeCounts& shoe, int hardTotal, bool hasAce);
+        static StateKey MakeKey(const ShoeCounts& shoe, int hardTotal, bool hasAce);
+
+        bool m_isHittingSoft17;
+        std::unordered_map<StateKey, DealerOutcome, StateHash> m_Memo;
+};
+
+inline DealerOdds::DealerOdds(bool isHittingSoft17): m_isHittingSoft17(isHittingSoft17) {
+    m_Memo.reserve(1 << 14);
+}
+
+inline bool DealerOdds::isHittingSoft17() const {
+    return m_isHittingSoft17;
+}
+
+inline DealerOutcome DealerOdds::FromUpCard(const ShoeCounts& shoe, int upCardValue) {
+    return FromHand(shoe, upCardValue, upCardValue == Card::ACE);
+}
+
+inline DealerOutcome DealerOdds::FromHand(const ShoeCounts& shoe, int hardTotal, bool hasAce) {
+    ShoeCounts remaining = shoe;
+    return Expand(remaining, hardTotal, hasAce);
+}
+
+inline int DealerOdds::GetMemoSize() const {
+    return static_cast<int>(m_Memo.size());
+}
+
+inline void DealerOdds::ClearMemo() {
+    m_Memo.clear();
+}
+
+inline std::size_t DealerOdds::StateHash::operator()(const StateKey& key) const {
+    //mix the two words so shoes that differ in a single count land far apart
+    std::uint64_t h = key.first ^ (static_cast<std::uint64_t>(key.second) * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 32;
+    return static_cast<std::size_t>(h);
+}
+
+inline DealerOdds::StateKey DealerOdds::MakeKey(const ShoeCounts& shoe, int hardTotal, bool hasAce) {
+    //an eight deck shoe has at most 32 of each value but 128 tens: six bits for each of the nine
+    //small values and eight for the tens fills 62 bits, and the hand goes in the second word
+    std::uint64_t packed = 0;
+    for (int v = Card::ACE; v < 10; ++v) {
+        packed = (packed << 6) | static_cast<std::uint64_t>(shoe.count[v]);
+    }
+    packed = (packed << 8) | static_cast<std::uint64_t>(shoe.count[10]);
+    std::uint32_t hand = static_cast<std::uint32_t>(hardTotal << 1) | (hasAce ? 1u : 0u);
+    return StateKey(packed, hand);
+}
+
+inline DealerOutcome DealerOdds::Expand(ShoeCounts& shoe, int hardTotal, bool hasAce) {
+    DealerOutcome outcome;
+    //the same total Hand::GetTotal would give
+    int total = (hasAce && hardTotal <= 11) ? hardTotal + 10 : hardTotal;
+    if (total > 21) {
+        outcome.probability[DealerOutcome::BUST] = 1.0;
+        return outcome;
+    }
+    bool isSoft17 = (total == 17 && total != hardTotal);
+    if (total >= 17 && !(m_isHittingSoft17 && isSoft17)) {
+        outcome.probability[total - 17] = 1.0;
+        return outcome;
+    }
+    //an empty shoe would leave the house short; the game always shuffles before that can happen
+    if (shoe.total == 0) {
+        return outcome;
+    }
+
+    StateKey key = MakeKey(shoe, hardTotal, hasAce);
+    std::unordered_map<StateKey, DealerOutcome, StateHash>::const_iterator found = m_Memo.find(key);
+    if (found != m_Memo.end()) {
+        return found->second;
+    }
+
+    //the house hits: every value still in the shoe could come next
+    double cardsLeft = shoe.total;
+    for (int v = Card::ACE; v <= 10; ++v) {
+        if (shoe.count[v] == 0) {
+            continue;
+        }
+        double chance = shoe.count[v] / cardsLeft;
+        shoe.Remove(v);
+        DealerOutcome next = Expand(shoe, hardTotal + v, hasAce || v == Card::ACE);
+        ++shoe.count[v];
+        ++shoe.total;
+        for (int r = 0; r < DealerOutcome::NUM_RESULTS; ++r) {
+            outcome.probability[r] += chance * next.probability[r];
+        }
+    }
+    m_Memo[key] = outcome;
+    return outcome;
+}
+
+#endif
@@ -0,0 +1,293 @@
+//Deck
+//A Blackjack shoe of one or more decks; shuffles and deals cards to any Hand
+
+#ifndef BLACKJACK_DECK_H
+#define BLACKJACK_DECK_H
+
+#include <cstdint>
+#include <random>
+
+#include "../../../Common/rng.h"
+#include "card.h"
+#include "hand.h"
+
+//how many undealt cards of each value a shoe holds; count[1] is aces, count[2] to count[9] the
+//number cards and count[10] the tens and face cards (count[0] is unused)
+struct ShoeCounts {
+    static const int NUM_VALUES = 11;
+
+    int count[NUM_VALUES];
+    int total;
+
+    ShoeCounts();
+    //a full shoe of numDecks standard decks
+    static ShoeCounts Full(int numDecks);
+    //takes one card of the given value out of the shoe
+    void Remove(int value);
+};
+
+inline ShoeCounts::ShoeCounts(): total(0) {
+    for (int v = 0; v < NUM_VALUES; ++v) {
+        count[v] = 0;
+    }
+}
+
+inline ShoeCounts ShoeCounts::Full(int numDecks) {
+    ShoeCounts shoe;
+    for (int v = Card::ACE; v < 10; ++v) {
+        shoe.count[v] = 4 * numDecks;
+    }
+    //ten, jack, queen and king
+    shoe.count[10] = 16 * numDecks;
+    shoe.total = 52 * numDecks;
+    return shoe;
+}
+
+inline void ShoeCounts::Remove(int value) {
+    --count[value];
+    --total;
+}
+
+//the deck keeps its cards by value in a fixed array; dealing copies one byte into a hand.
+//cards are never removed from the array: m_Cards[0, m_NumCards) are still to be dealt and
+//everything after has been dealt, so gathering the cards back up is just resetting the count.
+//the shuffle is lazy, each Deal swaps a uniformly chosen undealt card into the next position
+//(one step of Fisher-Yates), so a reshuffle costs nothing up front and only the cards that are
+//actually dealt ever get randomised.
+//the deck also keeps a running count for card counters: every dealt card adds its rank's tag,
+//looked up in a table so the update is the same load and add whatever the card (with no
+//counting system set every tag is 0 and the count just stays put). IS_COUNTED false leaves the
+//add out altogether, for measuring what keeping the count costs; everything else uses Deck
+template <bool IS_COUNTED>
+class BasicDeck {
+    public:
+        static const int CARDS_PER_DECK = 52;
+        static const int MAX_DECKS = 8;
+        //count tags are indexed by rank, 1 (ace) to 13 (king)
+        static const int NUM_RANKS = Card::KING + 1;
+
+        //a shoe of numDecks decks (1 to MAX_DECKS), with the cut card placed after the given
+        //fraction of the shoe has been dealt
+        BasicDeck(int numDecks = 1, double penetration = 0.75);
+        virtual ~BasicDeck();
+        //restart the shuffle sequence so a run can be reproduced; decks given the same seed
+        //but different streams draw from sequences that never overlap
+        void Seed(std::uint64_t seed, int stream = 0);
+        //create a fresh shoe of standard 52 card decks
+        void Populate();
+        //gather every card back into the shoe; cards are randomised as they are dealt
+        void Shuffle();
+        //deal one card to a hand; returns false, dealing nothing, if the shoe is empty
+        bool Deal(Hand& aHand);
+        //after a shuffle, takes the cards a hand still holds back out of the shoe, as when the
+        //discards are shuffled part way through a round; they count as dealt
+        void Withhold(const Hand& aHand);
+        //shuffles, then arranges the shoe so the next numCards cards dealt are the given ones in
+        //order (face up, whatever their face), after which dealing is random again; used to
+        //replay a logged round. returns false, leaving the shoe shuffled but not stacked, if the
+        //cards couldn't have come from this shoe
+        bool Stack(const Card cards[], int numCards);
+        //get the number of cards left in the shoe
+        int size() const;
+        //the number of decks in the shoe
+        int GetNumDecks() const;
+        //returns whether the cut card has come out, meaning the shoe is due a shuffle
+        bool isCutCardOut() const;
+        //counts the undealt cards by value
+        ShoeCounts GetCounts() const;
+        //sets the tag each rank adds to the running count, and the count a fresh shoe starts at
+        void SetCountTags(const int tags[NUM_RANKS], int initialCount);
+        //the sum of the tags of every card dealt since the shuffle, plus the initial count
+        int GetRunningCount() const;
+    private:
+        Card m_Cards[MAX_DECKS * CARDS_PER_DECK];
+        int m_NumDecks;
+        int m_NumCards;
+        //the shoe is due a shuffle once size() falls to this
+        int m_CutCard;
+        //seeded once, rather than per shuffle, so rounds don't pay for a random_device read
+        Rng m_Rng;
+        signed char m_CountTags[NUM_RANKS];
+        int m_InitialCount;
+        int m_RunningCount;
+        //how many of the cards still to be dealt were put in place by Stack
+        int m_NumStacked;
+};
+
+template <bool IS_COUNTED>
+inline BasicDeck<IS_COUNTED>::BasicDeck(int numDecks, double penetration):
+    m_NumDecks(numDecks < 1 ? 1 : (numDecks > MAX_DECKS ? MAX_DECKS : numDecks)),
+    m_NumCards(0),
+    m_CutCard(0),
+    m_Rng(std::random_device()()),
+    m_InitialCount(0),
+    m_RunningCount(0),
+    m_NumStacked(0)
+{
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        m_CountTags[r] = 0;
+    }
+    if (penetration < 0.0) {
+        penetration = 0.0;
+    }
+    else if (penetration > 1.0) {
+        penetration = 1.0;
+    }
+    int numCards = m_NumDecks * CARDS_PER_DECK;
+    m_CutCard = numCards - static_cast<int>(penetration * numCards);
+    Populate();
+}
+
+template <bool IS_COUNTED>
+inline BasicDeck<IS_COUNTED>::~BasicDeck() {}
+
+template <bool IS_COUNTED>
+inline void BasicDeck<IS_COUNTED>::Seed(std::uint64_t seed, int stream) {
+    m_Rng.Seed(seed);
+    for (int i = 0; i < stream; ++i) {
+        m_Rng.Jump();
+    }
+}
+
+template <bool IS_COUNTED>
+inline void BasicDeck<IS_COUNTED>::Populate() {
+    //create numDecks standard decks
+    m_NumCards = 0;
+    for (int d = 0; d < m_NumDecks; ++d) {
+        for (int s = Card::CLUBS; s <= Card::SPADES; ++s) {
+            for (int r = Card::ACE; r <= Card::KING; ++r) {
+                m_Cards[m_NumCards] = Card(static_cast<Card::Rank>(r), static_cast<Card::Suit>(s));
+                ++m_NumCards;
+            }
+        }
+    }
+}
+
+template <bool IS_COUNTED>
+inline void BasicDeck<IS_COUNTED>::Shuffle() {
+    //dealt cards were only copied out, so they are all still in the array
+    m_NumCards = m_NumDecks * CARDS_PER_DECK;
+    m_RunningCount = m_InitialCount;
+    m_NumStacked = 0;
+}
+
+template <bool IS_COUNTED>
+inline bool BasicDeck<IS_COUNTED>::Deal(Hand& aHand) {
+    if (m_NumCards > 0) {
+        //pick any undealt card and swap it into the last undealt position, then deal that;
+        //a stacked card is already in the last position, and choosing it with a conditional
+        //move rather than a branch keeps ordinary dealing exactly as it was
+        int chosen = m_Rng.Below(m_NumCards);
+        chosen = (m_NumStacked > 0) ? m_NumCards - 1 : chosen;
+        m_NumStacked -= (m_NumStacked > 0);
+        --m_NumCards;
+        Card aCard = m_Cards[chosen];
+        m_Cards[chosen] = m_Cards[m_NumCards];
+        m_Cards[m_NumCards] = aCard;
+        if (IS_COUNTED) {
+            m_RunningCount += m_CountTags[aCard.GetRank()];
+        }
+        aHand.Add(aCard);
+        return true;
+    }
+    return false;
+}
+
+template <bool IS_COUNTED>
+inline void BasicDeck<IS_COUNTED>::Withhold(const Hand& aHand) {
+    for (int c = 0; c < aHand.size(); ++c) {
+        //the hand's copy may be face down, so match on rank and suit as Stack does
+        Card held = aHand.GetCard(c);
+        for (int i = m_NumCards - 1; i >= 0; --i) {
+            if (m_Cards[i].GetRank() == held.GetRank() && m_Cards[i].GetSuit() == held.GetSuit()) {
+                --m_NumCards;
+                Card aCard = m_Cards[i];
+                m_Cards[i] = m_Cards[m_NumCards];
+                m_Cards[m_NumCards] = aCard;
+                if (IS_COUNTED) {
+                    m_RunningCount += m_CountTags[aCard.GetRank()];
+                }
+                break;
+            }
+        }
+    }
+}
+
+template <bool IS_COUNTED>
+inline bool BasicDeck<IS_COUNTED>::Stack(const Card cards[], int numCards) {
+    Shuffle();
+    if (numCards > m_NumCards) {
+        return false;
+    }
+    //the next card dealt is the last undealt one, so work down from the top of the shoe,
+    //swapping each card wanted into place from among the cards not yet placed
+    for (int i = 0; i < numCards; ++i) {
+        int position = m_NumCards - 1 - i;
+        int found = -1;
+        for (int j = position; j >= 0 && found < 0; --j) {
+            if (m_Cards[j].GetRank() == cards[i].GetRank() && m_Cards[j].GetSuit() == cards[i].GetSuit()) {
+                found = j;
+            }
+        }
+        if (found < 0) {
+            return false;
+        }
+        Card aCard = m_Cards[found];
+        m_Cards[found] = m_Cards[position];
+        m_Cards[position] = aCard;
+    }
+    m_NumStacked = numCards;
+    return true;
+}
+
+template <bool IS_COUNTED>
+inline int BasicDeck<IS_COUNTED>::size() const {
+    return m_NumCards;
+}
+
+template <bool IS_COUNTED>
+inline int BasicDeck<IS_COUNTED>::GetNumDecks() const {
+    return m_NumDecks;
+}
+
+template <bool IS_COUNTED>
+inline bool BasicDeck<IS_COUNTED>::isCutCardOut() const {
+    return (m_NumCards <= m_CutCard);
+}
+
+template <bool IS_COUNTED>
+inline ShoeCounts BasicDeck<IS_COUNTED>::GetCounts() const {
+    ShoeCounts shoe;
+    for (int i = 0; i < m_NumCards; ++i) {
+        //cards in the shoe are always face up, it's the hands that flip their copies
+        ++shoe.count[m_Cards[i].GetValue()];
+    }
+    shoe.total = m_NumCards;
+    return shoe;
+}
+
+template <bool IS_COUNTED>
+inline void BasicDeck<IS_COUNTED>::SetCountTags(const int tags[NUM_RANKS], int initialCount) {
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        m_CountTags[r] = static_cast<signed char>(tags[r]);
+    }
+    //the cards dealt since the last shuffle are the ones past m_NumCards, so the count can be
+    //brought up to date even part way through a shoe
+    m_InitialCount = initialCount;
+    m_RunningCount = initialCount;
+    for (int i = m_NumCards; i < m_NumDecks * CARDS_PER_DECK; ++i) {
+        m_RunningCount += m_CountTags[m_Cards[i].GetRank()];
+    }
+}
+
+template <bool IS_COUNTED>
+inline int BasicDeck<IS_COUNTED>::GetRunningCount() const {
+    return m_RunningCount;
+}
+
+//the shoe every table deals from
+typedef BasicDeck<true> Deck;
+//the same shoe keeping no running count, as a baseline for what counting costs
+typedef BasicDeck<false> UncountedDeck;
+
+#endif
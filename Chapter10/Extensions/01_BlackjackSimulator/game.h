@@ -0,0 +1,471 @@
+//Game
+//The rules of a round of Blackjack, separated from how the round is shown (or not shown)
+
+#ifndef BLACKJACK_GAME_H
+#define BLACKJACK_GAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "deck.h"
+#include "hand.h"
+#include "rules.h"
+
+//receives every event of a round; the default implementation ignores them all,
+//so a plain TableObserver is a silent table. a split hand is a GenericPlayer of its own (named
+//after its player), so every event about a hand is about split hands too
+class TableObserver {
+    public:
+        virtual ~TableObserver();
+        //the cut card came out (or the shoe ran low) and the shoe was shuffled
+        virtual void Reshuffle();
+        //everyone has their first two cards and the house card is hidden
+        virtual void ShowTable(const std::vector<GenericPlayer*>& players, const House& house);
+        //a generic player is about to be offered additional cards
+        virtual void StartTurn(const GenericPlayer& aGenericPlayer);
+        //a generic player has just been dealt an additional card
+        virtual void ShowHit(const GenericPlayer& aGenericPlayer);
+        //a generic player has gone over 21
+        virtual void Bust(const GenericPlayer& aGenericPlayer);
+        //a hand's stake has been doubled; the one card it gets follows as a hit
+        virtual void DoubleDown(const GenericPlayer& aHand);
+        //a pair has been split into two hands, each dealt a second card
+        virtual void Split(const GenericPlayer& aHand, const GenericPlayer& newHand);
+        //a hand has been given up for half its stake; it gets no other outcome
+        virtual void Surrender(const GenericPlayer& aHand);
+        //the house has flipped its first card
+        virtual void RevealHouse(const House& house);
+        //round outcomes for a player
+        virtual void Win(const GenericPlayer& aPlayer);
+        virtual void Lose(const GenericPlayer& aPlayer);
+        virtual void Push(const GenericPlayer& aPlayer);
+        //every outcome is in and the cards are about to be cleared away
+        virtual void EndRound();
+};
+
+inline TableObserver::~TableObserver() {}
+inline void TableObserver::Reshuffle() {}
+inline void TableObserver::ShowTable(const std::vector<GenericPlayer*>&, const House&) {}
+inline void TableObserver::StartTurn(const GenericPlayer&) {}
+inline void TableObserver::ShowHit(const GenericPlayer&) {}
+inline void TableObserver::Bust(const GenericPlayer&) {}
+inline void TableObserver::DoubleDown(const GenericPlayer&) {}
+inline void TableObserver::Split(const GenericPlayer&, const GenericPlayer&) {}
+inline void TableObserver::Surrender(const GenericPlayer&) {}
+inline void TableObserver::RevealHouse(const House&) {}
+inline void TableObserver::Win(const GenericPlayer&) {}
+inline void TableObserver::Lose(const GenericPlayer&) {}
+inline void TableObserver::Push(const GenericPlayer&) {}
+inline void TableObserver::EndRound() {}
+
+//the extra hand a split gives a player; its decisions are made by its player, through Decide
+class SplitHand : public GenericPlayer {
+    public:
+        SplitHand(const std::string& name = "");
+        virtual ~SplitHand();
+        //never asked, the player decides for the hand
+        virtual bool isHitting() const;
+};
+
+inline SplitHand::SplitHand(const std::string& name): GenericPlayer(name) {}
+
+inline SplitHand::~SplitHand() {}
+
+inline bool SplitHand::isHitting() const {
+    return false;
+}
+
+class Game {
+    public:
+        //the shoe is also shuffled before a round that starts with fewer than this many cards
+        //per hand that could be played (house included) behind the cut card. that only makes
+        //running out unlikely: a small shoe at a full table that splits can still run dry, and
+        //then the discards are shuffled mid-round (see Deal)
+        static const int MIN_CARDS_PER_SEAT = 6;
+
+        //a table dealt from a shoe of numDecks decks, shuffled when the cut card comes out, and
+        //played by the given rules
+        Game(TableObserver& observer, int numDecks = 1, double penetration = 0.75,
+             const TableRules& rules = TableRules());
+        ~Game();
+        //reseeds the shoe and starts from a freshly shuffled one
+        void Seed(std::uint64_t seed, int stream = 0);
+        //seats a player at the table, the game does not take ownership; the hands the player
+        //could split into are made here, so a round never allocates
+        void AddPlayer(GenericPlayer* pPlayer);
+        //the house, so players can see its up card
+        const House& GetHouse() const;
+        const TableRules& GetRules() const;
+        //plays one round of blackjack, asking each player's Decide for their decisions
+        void Play();
+        //a round can also be played in steps, for players whose decisions arrive from elsewhere
+        //(see tableServer.h): StartRound deals, then the hand to act Hits, Stands, and so on
+        //until every hand has had its turn and the house finishes the round
+        void StartRound();
+        //whether a round has been started and is waiting on a player
+        bool isRoundInProgress() const;
+        //the player whose turn it is, 0 between rounds
+        GenericPlayer* GetPlayerToAct() const;
+        //the hand being played, the player's own or one split from it; 0 between rounds
+        const GenericPlayer* GetHandToAct() const;
+        //the decisions the rules allow for the hand to act, 1 << decision for each
+        unsigned int GetAllowed() const;
+        //deals the hand to act a card; going bust ends its turn
+        void Hit();
+        //ends the turn of the hand to act
+        void Stand();
+        //doubles the hand's stake and deals it one last card
+        void DoubleDown();
+        //splits a pair into two hands, each dealt a new second card; the first is played first
+        void Split();
+        //gives the hand up for half its stake
+        void Surrender();
+        //carries out a decision for the hand to act, a decision it isn't allowed counts as a stand
+        void Act(GenericPlayer::Decision decision);
+        //the next round is dealt the given cards first, in order; returns false if the shoe
+        //couldn't hold them (see Deck::Stack)
+        bool Stack(const Card cards[], int numCards);
+    private:
+        Game(const Game&);
+        Game& operator=(const Game&);
+
+        //a hand in play this round, and the player it belongs to
+        struct PlayedHand {
+            GenericPlayer* pHand;
+            GenericPlayer* pPlayer;
+            int seat;
+            bool isSplit;
+            bool isSplitAces;
+            bool isSurrendered;
+        };
+
+        //deals a card, first shuffling the discards if the shoe has run dry; returns false, dealing
+        //nothing, only if every card in the shoe is on the table
+        bool Deal(GenericPlayer& aHand);
+        //give additional cards to a generic player
+        void AdditionalCards(GenericPlayer& aGenericPlayer);
+        //starts the turn of the hand to act; a split ace that may not be hit stands at once
+        void StartHand();
+        //moves the turn on to the next hand, or to the house once every hand is done
+        void NextTurn();
+        //the house plays its hand, and every hand wins, loses or pushes
+        void FinishRound();
+
+        Deck m_Deck;
+        House m_House;
+        TableRules m_Rules;
+        std::vector<GenericPlayer*> m_Players;
+        //every seat's spare hands, m_Rules.maxHands - 1 of them per seat
+        std::vector<SplitHand*> m_SplitHands;
+        //the hands in play in the order they are played, reserved for every hand a full table
+        //could split into; and how many hands each seat has this round
+        std::vector<PlayedHand> m_Hands;
+        std::vector<int> m_NumHands;
+        TableObserver* m_pObserver;
+        //index of the hand to act, m_Hands.size() when no round is in progress
+        std::size_t m_Turn;
+};
+
+inline Game::Game(TableObserver& observer, int numDecks, double penetration, const TableRules& rules):
+    m_Deck(numDecks, penetration),
+    m_Rules(rules),
+    m_pObserver(&observer),
+    m_Turn(0)
+{
+    m_Rules.maxHands = (m_Rules.maxHands < 1) ? 1 : m_Rules.maxHands;
+    m_Rules.maxHands = (m_Rules.maxHands > TableRules::MAX_HANDS_LIMIT) ? TableRules::MAX_HANDS_LIMIT : m_Rules.maxHands;
+    m_House.SetHittingSoft17(m_Rules.isHouseHittingSoft17);
+    m_Players.reserve(7);
+    m_Deck.Shuffle();
+}
+
+inline Game::~Game() {
+    std::vector<SplitHand*>::iterator pHand;
+    for (pHand = m_SplitHands.begin(); pHand != m_SplitHands.end(); ++pHand) {
+        delete *pHand;
+        *pHand = 0;
+    }
+}
+
+inline void Game::Seed(std::uint64_t seed, int stream) {
+    m_Deck.Seed(seed, stream);
+    m_Deck.Shuffle();
+}
+
+inline void Game::AddPlayer(GenericPlayer* pPlayer) {
+    m_Players.push_back(pPlayer);
+    m_NumHands.push_back(0);
+    //a split hand is named after its player and numbered, "Sam (hand 2)"
+    for (int h = 2; h <= m_Rules.maxHands; ++h) {
+        std::string name = pPlayer->GetName() + " (hand ";
+        name += static_cast<char>('0' + h);
+        name += ")";
+        m_SplitHands.push_back(new SplitHand(name));
+    }
+    m_Hands.reserve(m_Players.size() * m_Rules.maxHands);
+}
+
+inline const House& Game::GetHouse() const {
+    return m_House;
+}
+
+inline const TableRules& Game::GetRules() const {
+    return m_Rules;
+}
+
+inline bool Game::Stack(const Card cards[], int numCards) {
+    return m_Deck.Stack(cards, numCards);
+}
+
+inline bool Game::Deal(GenericPlayer& aHand) {
+    if (m_Deck.size() == 0) {
+        //as at a real table, everything but the cards still in play goes back into the shoe
+        m_Deck.Shuffle();
+        std::vector<GenericPlayer*>::const_iterator pPlayer;
+        for (pPlayer = m_Players.begin(); pPlayer != m_Players.end(); ++pPlayer) {
+            m_Deck.Withhold(*(*pPlayer));
+        }
+        //spare hands not split into this round hold no cards
+        std::vector<SplitHand*>::const_iterator pHand;
+        for (pHand = m_SplitHands.begin(); pHand != m_SplitHands.end(); ++pHand) {
+            m_Deck.Withhold(*(*pHand));
+        }
+        m_Deck.Withhold(m_House);
+        m_pObserver->Reshuffle();
+    }
+    return m_Deck.Deal(aHand);
+}
+
+inline void Game::AdditionalCards(GenericPlayer& aGenericPlayer) {
+    m_pObserver->StartTurn(aGenericPlayer);
+    //continue to deal a card so long as generic player isn't busted, wants another hit and
+    //there is a card left to deal
+    while (!(aGenericPlayer.isBusted()) && aGenericPlayer.isHitting() && Deal(aGenericPlayer)) {
+        m_pObserver->ShowHit(aGenericPlayer);
+        if (aGenericPlayer.isBusted()) {
+            m_pObserver->Bust(aGenericPlayer);
+        }
+    }
+}
+
+inline void Game::Play() {
+    StartRound();
+    //a hand's turn ends when it stands, busts, doubles or surrenders, so its player is asked
+    //until the turn moves on
+    while (m_Turn < m_Hands.size()) {
+        const PlayedHand& played = m_Hands[m_Turn];
+        Act(played.pPlayer->Decide(*played.pHand, GetAllowed()));
+    }
+}
+
+inline void Game::StartRound() {
+    //shuffle once the cut card has come out, or if the shoe couldn't see the round through
+    int maxHands = static_cast<int>(m_Players.size()) * m_Rules.maxHands;
+    int minCards = MIN_CARDS_PER_SEAT * (maxHands + 1);
+    if (m_Deck.isCutCardOut() || m_Deck.size() < minCards) {
+        m_Deck.Shuffle();
+        m_pObserver->Reshuffle();
+    }
+    //deal initial 2 cards to everyone
+    std::vector<GenericPlayer*>::iterator pPlayer;
+    for (int i = 0; i < 2; ++i) {
+        for (pPlayer = m_Players.begin(); pPlayer != m_Players.end(); ++pPlayer) {
+            Deal(*(*pPlayer));
+        }
+        Deal(m_House);
+    }
+    //hide house's first card
+    m_House.FlipFirstCard();
+    m_pObserver->ShowTable(m_Players, m_House);
+    //every player starts with their own hand, at one unit
+    m_Hands.clear();
+    for (std::size_t seat = 0; seat < m_Players.size(); ++seat) {
+        PlayedHand played = {m_Players[seat], m_Players[seat], static_cast<int>(seat), false, false, false};
+        m_Players[seat]->SetStake(1);
+        m_Hands.push_back(played);
+        m_NumHands[seat] = 1;
+    }
+    m_Turn = 0;
+    if (m_Hands.empty()) {
+        FinishRound();
+        return;
+    }
+    StartHand();
+}
+
+inline bool Game::isRoundInProgress() const {
+    return (m_Turn < m_Hands.size());
+}
+
+inline GenericPlayer* Game::GetPlayerToAct() const {
+    return isRoundInProgress() ? m_Hands[m_Turn].pPlayer : 0;
+}
+
+inline const GenericPlayer* Game::GetHandToAct() const {
+    return isRoundInProgress() ? m_Hands[m_Turn].pHand : 0;
+}
+
+inline unsigned int Game::GetAllowed() const {
+    const PlayedHand& played = m_Hands[m_Turn];
+    const GenericPlayer& aHand = *played.pHand;
+    unsigned int allowed = 1u << GenericPlayer::STAND;
+    bool isFirstTwo = (aHand.size() == 2);
+    //split aces get one card each, and can only be split again or hit if the rules say so
+    if (!played.isSplitAces || m_Rules.isHittingSplitAces) {
+        allowed |= 1u << GenericPlayer::HIT;
+        if (isFirstTwo && m_Rules.isDoubleAllowed && (!played.isSplit || m_Rules.isDoubleAfterSplit)) {
+            allowed |= 1u << GenericPlayer::DOUBLE;
+        }
+    }
+    if (aHand.isPair() && m_NumHands[played.seat] < m_Rules.maxHands &&
+        (!played.isSplitAces || m_Rules.isResplitAcesAllowed)) {
+        allowed |= 1u << GenericPlayer::SPLIT;
+    }
+    if (isFirstTwo && !played.isSplit && m_Rules.isSurrenderAllowed) {
+        allowed |= 1u << GenericPlayer::SURRENDER;
+    }
+    return allowed;
+}
+
+inline void Game::Act(GenericPlayer::Decision decision) {
+    if ((GetAllowed() & (1u << decision)) == 0) {
+        decision = GenericPlayer::STAND;
+    }
+    switch (decision) {
+        case GenericPlayer::HIT:
+            Hit();
+            break;
+        case GenericPlayer::DOUBLE:
+            DoubleDown();
+            break;
+        case GenericPlayer::SPLIT:
+            Split();
+            break;
+        case GenericPlayer::SURRENDER:
+            Surrender();
+            break;
+        default:
+            Stand();
+            break;
+    }
+}
+
+inline void Game::Hit() {
+    GenericPlayer& aHand = *m_Hands[m_Turn].pHand;
+    //with every card on the table there is nothing to hit with, so the hand stands
+    if (!Deal(aHand)) {
+        NextTurn();
+        return;
+    }
+    m_pObserver->ShowHit(aHand);
+    if (aHand.isBusted()) {
+        m_pObserver->Bust(aHand);
+        NextTurn();
+    }
+}
+
+inline void Game::Stand() {
+    NextTurn();
+}
+
+inline void Game::DoubleDown() {
+    GenericPlayer& aHand = *m_Hands[m_Turn].pHand;
+    aHand.SetStake(2 * aHand.GetStake());
+    m_pObserver->DoubleDown(aHand);
+    if (Deal(aHand)) {
+        m_pObserver->ShowHit(aHand);
+        if (aHand.isBusted()) {
+            m_pObserver->Bust(aHand);
+        }
+    }
+    NextTurn();
+}
+
+inline void Game::Split() {
+    PlayedHand& played = m_Hands[m_Turn];
+    int seat = played.seat;
+    //the seat's next spare hand takes the second card of the pair and the same stake
+    SplitHand& newHand = *m_SplitHands[seat * (m_Rules.maxHands - 1) + m_NumHands[seat] - 1];
+    ++m_NumHands[seat];
+    newHand.Clear();
+    newHand.SetStake(played.pHand->GetStake());
+    bool isAces = (played.pHand->GetCard(0).GetValue() == Card::ACE);
+    newHand.Add(played.pHand->RemoveLast());
+    played.isSplit = true;
+    played.isSplitAces = isAces;
+    Deal(*played.pHand);
+    Deal(newHand);
+    //the new hand is played straight after this one; the vector was reserved for every hand
+    //the table could split into, so inserting never reallocates
+    PlayedHand split = {&newHand, played.pPlayer, seat, true, isAces, false};
+    m_pObserver->Split(*played.pHand, newHand);
+    m_Hands.insert(m_Hands.begin() + m_Turn + 1, split);
+    //a split ace that can't be hit or split again is done already
+    if (GetAllowed() == (1u << GenericPlayer::STAND)) {
+        NextTurn();
+    }
+}
+
+inline void Game::Surrender() {
+    PlayedHand& played = m_Hands[m_Turn];
+    played.isSurrendered = true;
+    m_pObserver->Surrender(*played.pHand);
+    NextTurn();
+}
+
+inline void Game::StartHand() {
+    m_pObserver->StartTurn(*m_Hands[m_Turn].pHand);
+    if (GetAllowed() == (1u << GenericPlayer::STAND)) {
+        NextTurn();
+    }
+}
+
+inline void Game::NextTurn() {
+    ++m_Turn;
+    if (m_Turn < m_Hands.size()) {
+        StartHand();
+    }
+    else {
+        FinishRound();
+    }
+}
+
+inline void Game::FinishRound() {
+    //reveal house's first card
+    m_House.FlipFirstCard();
+    m_pObserver->RevealHouse(m_House);
+    //deal additional cards to house
+    AdditionalCards(m_House);
+    std::vector<PlayedHand>::iterator pPlayed;
+    for (pPlayed = m_Hands.begin(); pPlayed != m_Hands.end(); ++pPlayed) {
+        const GenericPlayer& aHand = *pPlayed->pHand;
+        if (pPlayed->isSurrendered) {
+            //settled when it was surrendered
+        }
+        else if (aHand.isBusted()) {
+            m_pObserver->Lose(aHand);
+        }
+        else if (m_House.isBusted() || aHand.GetTotal() > m_House.GetTotal()) {
+            //everyone still playing wins when the house busts
+            m_pObserver->Win(aHand);
+        }
+        else if (aHand.GetTotal() < m_House.GetTotal()) {
+            m_pObserver->Lose(aHand);
+        }
+        else {
+            m_pObserver->Push(aHand);
+        }
+    }
+    m_pObserver->EndRound();
+    //removing everyone's cards
+    for (pPlayed = m_Hands.begin(); pPlayed != m_Hands.end(); ++pPlayed) {
+        pPlayed->pHand->Clear();
+    }
+    m_House.Clear();
+    m_Hands.clear();
+    m_Turn = 0;
+}
+
+#endif
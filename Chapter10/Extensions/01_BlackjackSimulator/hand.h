@@ -0,0 +1,235 @@
+//Hand
+//A Blackjack hand, and the players (human, simulated or house) that are built on one
+
+#ifndef BLACKJACK_HAND_H
+#define BLACKJACK_HAND_H
+
+#include <ostream>
+#include <string>
+
+#include "card.h"
+
+//cards are held by value in a fixed array inside the hand, so a hand never touches the heap;
+//Add and Flip keep a running total so asking for the total never has to walk the cards
+class Hand {
+    public:
+        //the most cards a hand can hold: an eight deck shoe has 32 aces, twenty one of them
+        //total 21 and one more card must bust
+        static const int MAX_CARDS = 22;
+
+        Hand();
+        virtual ~Hand();
+        //adds a card to the hand
+        void Add(Card aCard);
+        //takes the last card back out of the hand, as when a pair is split
+        Card RemoveLast();
+        //flips the card at the given position, keeping the totals up to date
+        void Flip(int index);
+        //clears the hand of all cards;
+        void Clear();
+        //gets hand total value, intelligently treats aces 1 or 11
+        int GetTotal() const;
+        //returns whether GetTotal is counting an ace as 11
+        bool isSoft() const;
+        //the number of cards in the hand
+        int size() const;
+        //the card at the given position, in the order it was added
+        Card GetCard(int index) const;
+        //whether the hand is two cards of the same value, which can be split
+        bool isPair() const;
+    protected:
+        Card m_Cards[MAX_CARDS];
+        int m_NumCards;
+        //sum of the face up cards counting every ace as 1
+        int m_HardTotal;
+        //number of face up aces
+        int m_NumAces;
+        //number of face down cards, a hand with any reports a total of 0
+        int m_NumFaceDown;
+};
+
+inline Hand::Hand(): m_NumCards(0), m_HardTotal(0), m_NumAces(0), m_NumFaceDown(0) {}
+
+inline Hand::~Hand() {}
+
+inline void Hand::Add(Card aCard) {
+    //the deck can never deal a hand past MAX_CARDS, as the hand busts first
+    m_Cards[m_NumCards] = aCard;
+    ++m_NumCards;
+    //GetValue is 0 for a face down card, so only face up cards count
+    m_HardTotal += aCard.GetValue();
+    m_NumAces += (aCard.GetValue() == Card::ACE);
+    m_NumFaceDown += !aCard.isFaceUp();
+}
+
+inline Card Hand::RemoveLast() {
+    --m_NumCards;
+    Card aCard = m_Cards[m_NumCards];
+    m_HardTotal -= aCard.GetValue();
+    m_NumAces -= (aCard.GetValue() == Card::ACE);
+    m_NumFaceDown -= !aCard.isFaceUp();
+    return aCard;
+}
+
+inline void Hand::Flip(int index) {
+    Card& aCard = m_Cards[index];
+    //take the card's contribution off, flip it, then put its new contribution back
+    m_HardTotal -= aCard.GetValue();
+    m_NumAces -= (aCard.GetValue() == Card::ACE);
+    m_NumFaceDown -= !aCard.isFaceUp();
+    aCard.Flip();
+    m_HardTotal += aCard.GetValue();
+    m_NumAces += (aCard.GetValue() == Card::ACE);
+    m_NumFaceDown += !aCard.isFaceUp();
+}
+
+inline void Hand::Clear() {
+    //cards are values, so there is nothing to free
+    m_NumCards = 0;
+    m_HardTotal = 0;
+    m_NumAces = 0;
+    m_NumFaceDown = 0;
+}
+
+inline int Hand::GetTotal() const {
+    //if any card is face down return 0; only the house's first card is ever dealt face down,
+    //so this is the book's rule of returning 0 while the first card is hidden
+    if (m_NumFaceDown > 0) {
+        return 0;
+    }
+    //if hand contains ace and total is low enough, treat ace as 11
+    //(add only 10 since the hard total already has 1 for the ace)
+    return isSoft() ? m_HardTotal + 10 : m_HardTotal;
+}
+
+inline bool Hand::isSoft() const {
+    //a hand is soft when it holds an ace and the hard total leaves room to count it as 11
+    return (m_NumFaceDown == 0 && m_NumAces > 0 && m_HardTotal <= 11);
+}
+
+inline int Hand::size() const {
+    return m_NumCards;
+}
+
+inline Card Hand::GetCard(int index) const {
+    return m_Cards[index];
+}
+
+inline bool Hand::isPair() const {
+    return (m_NumCards == 2 && m_Cards[0].GetValue() == m_Cards[1].GetValue());
+}
+
+class GenericPlayer : public Hand {
+    friend std::ostream& operator<<(std::ostream& os, const GenericPlayer& aGenericPlayer);
+
+    public:
+        //everything a player can do with a hand; which of these a table allows depends on its
+        //TableRules, and is passed to Decide as a set of bits, 1 << decision for each
+        enum Decision {STAND, HIT, DOUBLE, SPLIT, SURRENDER};
+
+        GenericPlayer(const std::string& name = "");
+        virtual ~GenericPlayer();
+        //indicates whether or not generic player wants to keep hitting
+        virtual bool isHitting() const = 0;
+        //the player's decision for one of their hands, chosen from the allowed ones. the
+        //default asks isHitting about the player's own hand, which is right for any player who
+        //never splits, as only a split gives a player a second hand
+        virtual Decision Decide(const Hand& aHand, unsigned int allowed) const;
+        //the units bet on the hand this round, which the game doubles on a double down
+        int GetStake() const;
+        void SetStake(int stake);
+        //returns whether generic player has busted - has a total greater than 21
+        bool isBusted() const;
+        //returns the generic player's name
+        const std::string& GetName() const;
+    protected:
+        std::string m_Name;
+        int m_Stake;
+};
+
+inline GenericPlayer::GenericPlayer(const std::string& name): m_Name(name), m_Stake(1) {}
+
+inline GenericPlayer::~GenericPlayer() {}
+
+inline GenericPlayer::Decision GenericPlayer::Decide(const Hand&, unsigned int) const {
+    return isHitting() ? HIT : STAND;
+}
+
+inline int GenericPlayer::GetStake() const {
+    return m_Stake;
+}
+
+inline void GenericPlayer::SetStake(int stake) {
+    m_Stake = stake;
+}
+
+inline bool GenericPlayer::isBusted() const {
+    return (GetTotal() > 21);
+}
+
+inline const std::string& GenericPlayer::GetName() const {
+    return m_Name;
+}
+
+class House : public GenericPlayer {
+    public:
+        House(const std::string& name = "House");
+        virtual ~House();
+        //indicates whether house is hitting - will always hit on 16 or less, and on soft 17
+        //too if the table's rules say so
+        virtual bool isHitting() const;
+        //whether the house hits soft 17 (H17) or stands on it (S17, the book's rule)
+        void SetHittingSoft17(bool isHittingSoft17);
+        //flips over first card
+        void FlipFirstCard();
+        //value of the house's face up card, 0 if the house has no up card yet
+        int GetUpCardValue() const;
+    private:
+        bool m_isHittingSoft17;
+};
+
+inline House::House(const std::string& name): GenericPlayer(name), m_isHittingSoft17(false) {}
+
+inline House::~House() {}
+
+inline bool House::isHitting() const {
+    int total = GetTotal();
+    return (total <= 16 || (m_isHittingSoft17 && total == 17 && isSoft()));
+}
+
+inline void House::SetHittingSoft17(bool isHittingSoft17) {
+    m_isHittingSoft17 = isHittingSoft17;
+}
+
+inline void House::FlipFirstCard() {
+    //flipping an empty hand is a no-op; the game never asks for it
+    if (m_NumCards > 0) {
+        Flip(0);
+    }
+}
+
+inline int House::GetUpCardValue() const {
+    //the first card is dealt face down, so the second is the one the players see
+    if (m_NumCards < 2) {
+        return 0;
+    }
+    return m_Cards[1].GetValue();
+}
+
+inline std::ostream& operator<<(std::ostream& os, const GenericPlayer& aGenericPlayer) {
+    os << aGenericPlayer.m_Name << ":\t";
+    if (aGenericPlayer.m_NumCards > 0) {
+        for (int i = 0; i < aGenericPlayer.m_NumCards; ++i) {
+            os << aGenericPlayer.m_Cards[i] << "\t";
+        }
+        if (aGenericPlayer.GetTotal() != 0) {
+            os << "(" << aGenericPlayer.GetTotal() << ")";
+        }
+    }
+    else {
+        os << "<empty>";
+    }
+    return os;
+}
+
+#endif
@@ -0,0 +1,146 @@
+//Hand Batch
+//Many hands stored column by column, so their totals can be worked out for a block of hands at once
+
+#ifndef BLACKJACK_HANDBATCH_H
+#define BLACKJACK_HANDBATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "card.h"
+#include "hand.h"
+
+//a Hand keeps its cards together and its totals up to date as cards are added. a batch turns
+//that around for analysing lots of hands that already exist: the hands sit side by side in
+//blocks of LANES, and the first card of every hand in a block comes first, then every second
+//card and so on. working out the totals is then the same few byte operations applied to a whole
+//row of LANES cards at a time, which the compiler turns into vector instructions (16 hands per
+//instruction with SSE2, 32 with AVX2) with no branches for aces or face down cards.
+//Evaluate gives exactly what each hand's GetTotal, isSoft and bust check would
+class HandBatch {
+    public:
+        //hands per block, one per byte of a 256 bit vector register
+        static const int LANES = 32;
+
+        HandBatch();
+        //removes every hand, keeping the memory for the next ones
+        void Clear();
+        //makes room for the given number of hands without reallocating as they are added
+        void Reserve(int numHands);
+        //copies a hand's cards into the next lane, returns its index in the batch
+        int Add(const Hand& aHand);
+        //the number of hands in the batch
+        int size() const;
+        //works out the total, softness and bust flag of every hand
+        void Evaluate();
+        //results for the hand at the given index, valid after Evaluate
+        int GetTotal(int index) const;
+        bool isSoft(int index) const;
+        bool isBusted(int index) const;
+    private:
+        //cards are stored as their rank, with FACE_DOWN set for a face down card; an empty slot
+        //is 0, which counts for nothing, so short hands need no special case
+        static const unsigned char RANK_BITS = 0x0F;
+        static const unsigned char FACE_DOWN = 0x10;
+
+        struct Block {
+            //cards[slot][lane] is card number slot of the hand in that lane
+            unsigned char cards[Hand::MAX_CARDS][LANES];
+            unsigned char totals[LANES];
+            unsigned char isSoft[LANES];
+            unsigned char isBusted[LANES];
+            //the most cards any hand in the block has, the rows past it are all empty
+            int numSlots;
+        };
+
+        static void EvaluateBlock(Block& block);
+
+        std::vector<Block> m_Blocks;
+        int m_NumHands;
+};
+
+inline HandBatch::HandBatch(): m_NumHands(0) {}
+
+inline void HandBatch::Clear() {
+    m_Blocks.clear();
+    m_NumHands = 0;
+}
+
+inline void HandBatch::Reserve(int numHands) {
+    m_Blocks.reserve((numHands + LANES - 1) / LANES);
+}
+
+inline int HandBatch::Add(const Hand& aHand) {
+    int lane = m_NumHands % LANES;
+    if (lane == 0) {
+        //Block() is zeroed, so a new block starts with every slot empty
+        m_Blocks.push_back(Block());
+    }
+    Block& block = m_Blocks.back();
+    for (int slot = 0; slot < aHand.size(); ++slot) {
+        Card aCard = aHand.GetCard(slot);
+        block.cards[slot][lane] = static_cast<unsigned char>(aCard.GetRank() | (aCard.isFaceUp() ? 0 : FACE_DOWN));
+    }
+    block.numSlots = (aHand.size() > block.numSlots) ? aHand.size() : block.numSlots;
+    return m_NumHands++;
+}
+
+inline int HandBatch::size() const {
+    return m_NumHands;
+}
+
+inline void HandBatch::Evaluate() {
+    for (std::size_t b = 0; b < m_Blocks.size(); ++b) {
+        EvaluateBlock(m_Blocks[b]);
+    }
+}
+
+inline void HandBatch::EvaluateBlock(Block& block) {
+    //every loop over lanes has the same fixed length and no branches, so each is a handful of
+    //vector instructions; the conditionals become compares and blends
+    unsigned char hardTotals[LANES];
+    unsigned char numAces[LANES];
+    unsigned char faceDown[LANES];
+    for (int i = 0; i < LANES; ++i) {
+        hardTotals[i] = 0;
+        numAces[i] = 0;
+        faceDown[i] = 0;
+    }
+    for (int slot = 0; slot < block.numSlots; ++slot) {
+        const unsigned char* cards = block.cards[slot];
+        for (int i = 0; i < LANES; ++i) {
+            unsigned char rank = cards[i] & RANK_BITS;
+            //0xFF for a face up card (or an empty slot, whose rank of 0 adds nothing), else 0
+            unsigned char upMask = ((cards[i] & FACE_DOWN) == 0) ? 0xFF : 0;
+            //jack, queen and king count 10, the same as Card::GetValue
+            unsigned char value = (rank < 10) ? rank : 10;
+            hardTotals[i] += value & upMask;
+            numAces[i] += (rank == Card::ACE) & upMask;
+            faceDown[i] |= cards[i] & FACE_DOWN;
+        }
+    }
+    for (int i = 0; i < LANES; ++i) {
+        //the same rules as Hand: soft when an ace can count 11 without going over 21, and a
+        //total of 0 while any card is face down
+        unsigned char soft = (faceDown[i] == 0 && numAces[i] > 0 && hardTotals[i] <= 11) ? 1 : 0;
+        unsigned char total = hardTotals[i] + (soft ? 10 : 0);
+        total = (faceDown[i] == 0) ? total : 0;
+        block.totals[i] = total;
+        block.isSoft[i] = soft;
+        block.isBusted[i] = (total > 21) ? 1 : 0;
+    }
+}
+
+inline int HandBatch::GetTotal(int index) const {
+    return m_Blocks[index / LANES].totals[index % LANES];
+}
+
+inline bool HandBatch::isSoft(int index) const {
+    return m_Blocks[index / LANES].isSoft[index % LANES] != 0;
+}
+
+inline bool HandBatch::isBusted(int index) const {
+    return m_Blocks[index / LANES].isBusted[index % LANES] != 0;
+}
+
+#endif
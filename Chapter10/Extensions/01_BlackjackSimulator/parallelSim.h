@@ -0,0 +1,72 @@
+//Parallel Simulator
+//Splits a simulation across threads, one independent table per thread
+
+#ifndef BLACKJACK_PARALLEL_SIM_H
+#define BLACKJACK_PARALLEL_SIM_H
+
+#include <thread>
+#include <vector>
+
+#include "counting.h"
+#include "policy.h"
+#include "simulator.h"
+
+//plays one thread's share of the rounds on its own table and reports the counts once at the end;
+//Table is any simulator that can be constructed from a Rule and a SimConfig, and reports its
+//counts as a Table::Stats that can Merge with another
+template <typename Table, typename Rule>
+void runShare(const Rule* pRule, SimConfig config, long long rounds, typename Table::Stats* pResult) {
+    //the simulator lives on this thread's stack, so its shoe, players and counters are
+    //never touched by another thread while it runs
+    Table sim(*pRule, config);
+    sim.Run(rounds);
+    *pResult = sim.GetStats();
+}
+
+//plays the given number of rounds split across numThreads independent tables and merges the
+//results; thread i deals from random stream i of the configured seed, so a run is reproducible
+//for a given seed and thread count. the rule is only read, so every thread can share it
+template <typename Table, typename Rule>
+typename Table::Stats RunTables(const Rule& rule, const SimConfig& config, long long rounds, int numThreads) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    std::vector<typename Table::Stats> results(numThreads);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        SimConfig threadConfig = config;
+        threadConfig.stream = config.stream + i;
+        //spread any remainder over the first few threads
+        long long share = rounds / numThreads + (i < rounds % numThreads ? 1 : 0);
+        threads.push_back(std::thread(runShare<Table, Rule>, &rule, threadConfig, share, &results[i]));
+    }
+
+    typename Table::Stats total;
+    for (int i = 0; i < numThreads; ++i) {
+        threads[i].join();
+        total.Merge(results[i]);
+    }
+    return total;
+}
+
+//runs Simulators, whose players decide through a virtual isHitting
+template <typename Rule>
+SimStats RunParallel(const Rule& rule, const SimConfig& config, long long rounds, int numThreads) {
+    return RunTables<Simulator>(rule, config, rounds, numThreads);
+}
+
+//runs PolicySimulators, whose policy is compiled into the round loop
+template <typename Policy>
+SimStats RunParallelPolicy(const Policy& policy, const SimConfig& config, long long rounds, int numThreads) {
+    return RunTables<PolicySimulator<Policy> >(policy, config, rounds, numThreads);
+}
+
+//runs CountingSimulators, betting by the count
+template <typename Policy>
+CountStats RunParallelCounting(const CountingRule<Policy>& rule, const SimConfig& config, long long rounds,
+                               int numThreads) {
+    return RunTables<CountingSimulator<Policy> >(rule, config, rounds, numThreads);
+}
+
+#endif
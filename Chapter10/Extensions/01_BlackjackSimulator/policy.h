@@ -0,0 +1,195 @@
+//Policy
+//A simulated table whose hit/stand rule is a template parameter, so the round loop has no
+//virtual calls left in it and the compiler can inline the whole thing
+
+#ifndef BLACKJACK_POLICY_H
+#define BLACKJACK_POLICY_H
+
+#include "deck.h"
+#include "hand.h"
+#include "simulator.h"
+#include "strategy.h"
+
+//a policy is any type with a const member
+//    bool isHitting(int total, bool isSoft, int upCardValue) const;
+//it is copied into the table, so it should be small
+
+//hits until the total reaches STAND_ON; ThresholdPolicy<17> plays like the house
+template <int STAND_ON>
+struct ThresholdPolicy {
+    bool isHitting(int total, bool, int) const;
+};
+
+template <int STAND_ON>
+inline bool ThresholdPolicy<STAND_ON>::isHitting(int total, bool, int) const {
+    return (total < STAND_ON);
+}
+
+//plays one of the HitDecision functions, fixed at compile time rather than held in a pointer
+template <HitDecision DECIDE>
+struct DecisionPolicy {
+    bool isHitting(int total, bool isSoft, int upCardValue) const;
+};
+
+template <HitDecision DECIDE>
+inline bool DecisionPolicy<DECIDE>::isHitting(int total, bool isSoft, int upCardValue) const {
+    return DECIDE(total, isSoft, upCardValue);
+}
+
+//plays a BasicStrategy table, which must outlive the policy
+class TablePolicy {
+    public:
+        TablePolicy(const BasicStrategy& strategy);
+        bool isHitting(int total, bool isSoft, int upCardValue) const;
+    private:
+        const BasicStrategy* m_pStrategy;
+};
+
+inline TablePolicy::TablePolicy(const BasicStrategy& strategy): m_pStrategy(&strategy) {}
+
+inline bool TablePolicy::isHitting(int total, bool isSoft, int upCardValue) const {
+    return m_pStrategy->isHitting(total, isSoft, upCardValue);
+}
+
+//plays the same rounds as a Simulator seated with the equivalent rule under the book's table
+//rules (hit or stand only, the house standing on soft 17), dealing the same cards in
+//the same order and counting the same outcomes, but the seats are plain Hands, the policy is a
+//member and the outcomes go straight into the counters rather than through a TableObserver.
+//DeckType is the shoe, an UncountedDeck to measure the table without the running count
+template <typename Policy, typename DeckType = Deck>
+class PolicySimulator {
+    public:
+        static const int MAX_SEATS = 7;
+        typedef SimStats Stats;
+
+        PolicySimulator(const Policy& policy, const SimConfig& config);
+        //plays the given number of rounds
+        void Run(long long rounds);
+        //plays one round the same way Game::Play does, and returns the players' combined winnings
+        //at one unit per hand; the shoe is left shuffled if the next round is due a fresh one
+        int PlayRound();
+        const SimStats& GetStats() const;
+        //the shoe, whose running count can be read between rounds
+        DeckType& GetDeck();
+        const DeckType& GetDeck() const;
+    private:
+        //shuffles if the cut card has come out, or if the shoe couldn't see a round through
+        void ShuffleIfDue();
+
+        DeckType m_Deck;
+        House m_House;
+        Hand m_Seats[MAX_SEATS];
+        int m_NumSeats;
+        Policy m_Policy;
+        SimStats m_Stats;
+};
+
+template <typename Policy, typename DeckType>
+inline PolicySimulator<Policy, DeckType>::PolicySimulator(const Policy& policy, const SimConfig& config):
+    m_Deck(config.numDecks, config.penetration),
+    m_NumSeats(config.numPlayers < MAX_SEATS ? config.numPlayers : MAX_SEATS),
+    m_Policy(policy)
+{
+    m_Deck.Seed(config.seed, config.stream);
+    m_Deck.Shuffle();
+}
+
+template <typename Policy, typename DeckType>
+inline void PolicySimulator<Policy, DeckType>::Run(long long rounds) {
+    for (long long i = 0; i < rounds; ++i) {
+        PlayRound();
+    }
+}
+
+template <typename Policy, typename DeckType>
+inline const SimStats& PolicySimulator<Policy, DeckType>::GetStats() const {
+    return m_Stats;
+}
+
+template <typename Policy, typename DeckType>
+inline DeckType& PolicySimulator<Policy, DeckType>::GetDeck() {
+    return m_Deck;
+}
+
+template <typename Policy, typename DeckType>
+inline const DeckType& PolicySimulator<Policy, DeckType>::GetDeck() const {
+    return m_Deck;
+}
+
+template <typename Policy, typename DeckType>
+inline void PolicySimulator<Policy, DeckType>::ShuffleIfDue() {
+    int minCards = Game::MIN_CARDS_PER_SEAT * (m_NumSeats + 1);
+    if (m_Deck.isCutCardOut() || m_Deck.size() < minCards) {
+        m_Deck.Shuffle();
+    }
+}
+
+template <typename Policy, typename DeckType>
+inline int PolicySimulator<Policy, DeckType>::PlayRound() {
+    //deal initial 2 cards to everyone
+    for (int i = 0; i < 2; ++i) {
+        for (int seat = 0; seat < m_NumSeats; ++seat) {
+            m_Deck.Deal(m_Seats[seat]);
+        }
+        m_Deck.Deal(m_House);
+    }
+    //the house's first card stays face down while the players decide
+    m_House.FlipFirstCard();
+    int upCardValue = m_House.GetUpCardValue();
+    for (int seat = 0; seat < m_NumSeats; ++seat) {
+        Hand& aHand = m_Seats[seat];
+        while (aHand.GetTotal() <= 21 && m_Policy.isHitting(aHand.GetTotal(), aHand.isSoft(), upCardValue)) {
+            //an empty shoe ends the turn, which ShuffleIfDue makes all but impossible
+            if (!m_Deck.Deal(aHand)) {
+                break;
+            }
+        }
+    }
+    //the house draws to 17 whatever the players did, as in Game::Play
+    m_House.FlipFirstCard();
+    while (m_House.GetTotal() <= 16) {
+        if (!m_Deck.Deal(m_House)) {
+            break;
+        }
+    }
+    int houseTotal = m_House.GetTotal();
+    if (houseTotal > 21) {
+        ++m_Stats.houseBusts;
+        //a busted house still beats a busted player
+        houseTotal = 0;
+    }
+    int net = 0;
+    for (int seat = 0; seat < m_NumSeats; ++seat) {
+        int total = m_Seats[seat].GetTotal();
+        if (total > 21) {
+            ++m_Stats.losses;
+            ++m_Stats.playerBusts;
+            --net;
+        }
+        else if (total > houseTotal) {
+            ++m_Stats.wins;
+            ++net;
+        }
+        else if (total < houseTotal) {
+            ++m_Stats.losses;
+            --net;
+        }
+        else {
+            ++m_Stats.pushes;
+        }
+        m_Seats[seat].Clear();
+    }
+    m_House.Clear();
+    ++m_Stats.rounds;
+    m_Stats.hands += m_NumSeats;
+    m_Stats.wagered += m_NumSeats;
+    m_Stats.net += net;
+    m_Stats.bankroll.Add(net);
+    //Game::Play checks the shoe at the start of a round; checking at the end of the previous
+    //one deals exactly the same cards, and means a counter betting on the next round sees
+    //the count of the shoe that round will actually be dealt from
+    ShuffleIfDue();
+    return net;
+}
+
+#endif
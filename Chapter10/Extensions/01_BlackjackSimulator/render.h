@@ -0,0 +1,103 @@
+//Render
+//Builds the text of a table in one reusable buffer and writes it out a whole frame at a time
+
+#ifndef BLACKJACK_RENDER_H
+#define BLACKJACK_RENDER_H
+
+#include <ostream>
+#include <string>
+
+#include "card.h"
+#include "hand.h"
+
+//appends a number's digits to text; they are worked out backwards into a small array, with no
+//stream or temporary string involved
+void appendNumber(std::string& text, long long number);
+
+//a frame is everything shown for one change to the table; it is built up in a string that keeps
+//its memory from frame to frame and handed to the stream in a single write, without the flush
+//std::endl would add to every line
+class TableRenderer {
+    public:
+        //room for a full table of long hands without the buffer ever growing
+        static const int RESERVED_BYTES = 4096;
+
+        TableRenderer(std::ostream& os);
+        //a hand as GenericPlayer's operator<< prints it, "name:\tcard\tcard\t(total)"
+        void AddHand(const GenericPlayer& aGenericPlayer);
+        void AddText(const std::string& text);
+        void AddText(const char* text);
+        void AddNumber(int number);
+        void NewLine();
+        //writes the frame in one call and starts the next one in the same buffer
+        void Write();
+    private:
+        std::ostream* m_pOs;
+        std::string m_Frame;
+};
+
+inline TableRenderer::TableRenderer(std::ostream& os): m_pOs(&os) {
+    m_Frame.reserve(RESERVED_BYTES);
+}
+
+inline void TableRenderer::AddHand(const GenericPlayer& aGenericPlayer) {
+    m_Frame += aGenericPlayer.GetName();
+    m_Frame += ":\t";
+    if (aGenericPlayer.size() > 0) {
+        for (int i = 0; i < aGenericPlayer.size(); ++i) {
+            m_Frame += aGenericPlayer.GetCard(i).GetText();
+            m_Frame += '\t';
+        }
+        int total = aGenericPlayer.GetTotal();
+        if (total != 0) {
+            m_Frame += '(';
+            AddNumber(total);
+            m_Frame += ')';
+        }
+    }
+    else {
+        m_Frame += "<empty>";
+    }
+}
+
+inline void TableRenderer::AddText(const std::string& text) {
+    m_Frame += text;
+}
+
+inline void TableRenderer::AddText(const char* text) {
+    m_Frame += text;
+}
+
+inline void appendNumber(std::string& text, long long number) {
+    char digits[20];
+    int numDigits = 0;
+    unsigned long long magnitude = (number < 0) ? 0ull - static_cast<unsigned long long>(number) : number;
+    do {
+        digits[numDigits++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (number < 0) {
+        text += '-';
+    }
+    while (numDigits > 0) {
+        text += digits[--numDigits];
+    }
+}
+
+inline void TableRenderer::AddNumber(int number) {
+    appendNumber(m_Frame, number);
+}
+
+inline void TableRenderer::NewLine() {
+    m_Frame += '\n';
+}
+
+inline void TableRenderer::Write() {
+    if (!m_Frame.empty()) {
+        m_pOs->write(m_Frame.data(), m_Frame.size());
+        //clear keeps the capacity, so the next frame reuses the same memory
+        m_Frame.clear();
+    }
+}
+
+#endif
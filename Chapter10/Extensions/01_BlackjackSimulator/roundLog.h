@@ -0,0 +1,608 @@
+//Round Log
+//An append-only binary log of Blackjack rounds: a recorder that captures each round as it is
+//played, a buffered writer, a memory mapped reader and the pieces needed to replay a round
+
+#ifndef BLACKJACK_ROUND_LOG_H
+#define BLACKJACK_ROUND_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "card.h"
+#include "game.h"
+#include "hand.h"
+
+//what a log was recorded from; written once at the start of the file. with the seed and stream
+//a round's position in the log says exactly which round of which run it was
+struct LogHeader {
+    static const int SIZE = 24;
+    //the first 8 bytes of every log, "BJLOG" then the format version
+    static const char* Magic();
+
+    std::uint64_t seed;
+    std::uint32_t stream;
+    int numPlayers;
+    int numDecks;
+    double penetration;
+
+    LogHeader();
+    //writes the header as SIZE little endian bytes
+    void Encode(unsigned char* out) const;
+    //reads a header, returning false if the bytes aren't one
+    bool Decode(const unsigned char* in);
+};
+
+inline LogHeader::LogHeader(): seed(0), stream(0), numPlayers(1), numDecks(1), penetration(0.75) {}
+
+inline const char* LogHeader::Magic() {
+    return "BJLOG001";
+}
+
+inline void LogHeader::Encode(unsigned char* out) const {
+    std::memcpy(out, Magic(), 8);
+    for (int i = 0; i < 8; ++i) {
+        out[8 + i] = static_cast<unsigned char>(seed >> (8 * i));
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[16 + i] = static_cast<unsigned char>(stream >> (8 * i));
+    }
+    out[20] = static_cast<unsigned char>(numPlayers);
+    out[21] = static_cast<unsigned char>(numDecks);
+    //penetration in 1/256ths of the shoe is plenty to place the same cut card
+    int fraction = static_cast<int>(penetration * 256.0 + 0.5);
+    out[22] = static_cast<unsigned char>(fraction & 0xFF);
+    out[23] = static_cast<unsigned char>(fraction >> 8);
+}
+
+inline bool LogHeader::Decode(const unsigned char* in) {
+    if (std::memcmp(in, Magic(), 8) != 0) {
+        return false;
+    }
+    seed = 0;
+    for (int i = 0; i < 8; ++i) {
+        seed |= static_cast<std::uint64_t>(in[8 + i]) << (8 * i);
+    }
+    stream = 0;
+    for (int i = 0; i < 4; ++i) {
+        stream |= static_cast<std::uint32_t>(in[16 + i]) << (8 * i);
+    }
+    numPlayers = in[20];
+    numDecks = in[21];
+    penetration = (in[22] | (in[23] << 8)) / 256.0;
+    return (numPlayers >= 1 && numPlayers <= 7 && numDecks >= 1 && numDecks <= Deck::MAX_DECKS);
+}
+
+//one round: every card in the order it was dealt, every hit (1) or stand (0) the players made in
+//the order they made them, and each player's result. the house's draws follow from its cards,
+//so only the players' decisions are kept. encoded, a round is
+//    length, flags, number of cards, cards..., number of decisions, decision bits..., results...
+//with a card as its one byte, decisions 8 to a byte and results 4 to a byte, so a one player
+//round is usually 12 bytes
+struct RoundRecord {
+    enum Result {LOSE, PUSH, WIN};
+    //the most cards one round can deal: every hand, the house's included, at its most
+    static const int MAX_CARDS = 8 * Hand::MAX_CARDS;
+    //every player hitting as often as a hand can
+    static const int MAX_DECISIONS = 7 * Hand::MAX_CARDS;
+    static const int MAX_PLAYERS = 7;
+    //the largest encoded record, which still fits the one byte length
+    static const int MAX_BYTES = 3 + MAX_CARDS + 1 + (MAX_DECISIONS + 7) / 8 + (MAX_PLAYERS + 3) / 4;
+    static const unsigned char SHUFFLED = 0x01;
+
+    bool shuffled;
+    int numCards;
+    Card cards[MAX_CARDS];
+    int numDecisions;
+    unsigned char decisions[(MAX_DECISIONS + 7) / 8];
+    int numPlayers;
+    unsigned char results[MAX_PLAYERS];
+
+    RoundRecord();
+    void Clear();
+    void AddCard(Card aCard);
+    void AddDecision(bool isHit);
+    bool GetDecision(int index) const;
+    //writes the record, returning the number of bytes used (at most MAX_BYTES)
+    int Encode(unsigned char* out) const;
+    //reads a record for a table of numPlayers, returning false if it is malformed
+    bool Decode(const unsigned char* in, int size, int players);
+};
+
+static_assert(RoundRecord::MAX_BYTES <= 256, "a round's length has to fit in its one byte length");
+
+inline RoundRecord::RoundRecord() {
+    Clear();
+}
+
+inline void RoundRecord::Clear() {
+    shuffled = false;
+    numCards = 0;
+    numDecisions = 0;
+    numPlayers = 0;
+}
+
+inline void RoundRecord::AddCard(Card aCard) {
+    //the house's first card is face down when it's dealt; the log keeps every card face up
+    cards[numCards] = Card(aCard.GetRank(), aCard.GetSuit(), true);
+    ++numCards;
+}
+
+inline void RoundRecord::AddDecision(bool isHit) {
+    unsigned char bit = static_cast<unsigned char>(1 << (numDecisions & 7));
+    if ((numDecisions & 7) == 0) {
+        decisions[numDecisions >> 3] = 0;
+    }
+    decisions[numDecisions >> 3] |= isHit ? bit : 0;
+    ++numDecisions;
+}
+
+inline bool RoundRecord::GetDecision(int index) const {
+    return ((decisions[index >> 3] >> (index & 7)) & 1) != 0;
+}
+
+inline int RoundRecord::Encode(unsigned char* out) const {
+    int size = 1;
+    out[size++] = shuffled ? SHUFFLED : 0;
+    out[size++] = static_cast<unsigned char>(numCards);
+    std::memcpy(out + size, cards, numCards);
+    size += numCards;
+    out[size++] = static_cast<unsigned char>(numDecisions);
+    int decisionBytes = (numDecisions + 7) / 8;
+    std::memcpy(out + size, decisions, decisionBytes);
+    size += decisionBytes;
+    for (int i = 0; i < numPlayers; i += 4) {
+        unsigned char packed = 0;
+        for (int j = i; j < i + 4 && j < numPlayers; ++j) {
+            packed |= static_cast<unsigned char>(results[j] << (2 * (j - i)));
+        }
+        out[size++] = packed;
+    }
+    //the length byte counts what follows it
+    out[0] = static_cast<unsigned char>(size - 1);
+    return size;
+}
+
+inline bool RoundRecord::Decode(const unsigned char* in, int size, int players) {
+    Clear();
+    if (size < 4 || in[0] != size - 1) {
+        return false;
+    }
+    int at = 1;
+    shuffled = (in[at++] & SHUFFLED) != 0;
+    numCards = in[at++];
+    if (numCards > MAX_CARDS || at + numCards >= size) {
+        return false;
+    }
+    std::memcpy(cards, in + at, numCards);
+    at += numCards;
+    numDecisions = in[at++];
+    int decisionBytes = (numDecisions + 7) / 8;
+    int resultBytes = (players + 3) / 4;
+    if (numDecisions > MAX_DECISIONS || at + decisionBytes + resultBytes != size) {
+        return false;
+    }
+    std::memcpy(decisions, in + at, decisionBytes);
+    at += decisionBytes;
+    numPlayers = players;
+    for (int i = 0; i < players; ++i) {
+        results[i] = (in[at + i / 4] >> (2 * (i % 4))) & 3;
+    }
+    return true;
+}
+
+//collects encoded rounds in a buffer and writes the buffer out whenever it fills, so logging a
+//round costs a copy into memory and the file only sees large writes
+class LogWriter {
+    public:
+        static const int BUFFER_SIZE = 1 << 20;
+
+        LogWriter();
+        ~LogWriter();
+        //creates (or truncates) the file and writes the header; returns false on failure
+        bool Open(const std::string& path, const LogHeader& header);
+        //space for one record, to be filled and then committed
+        unsigned char* Reserve();
+        void Commit(int size);
+        //writes out anything buffered and closes the file; returns false if any write failed
+        bool Close();
+        //bytes written, header included
+        long long GetBytesWritten() const;
+    private:
+        LogWriter(const LogWriter&);
+        LogWriter& operator=(const LogWriter&);
+        void Flush();
+
+        std::FILE* m_pFile;
+        std::vector<unsigned char> m_Buffer;
+        int m_Used;
+        long long m_BytesWritten;
+        bool m_isGood;
+};
+
+inline LogWriter::LogWriter(): m_pFile(0), m_Buffer(BUFFER_SIZE), m_Used(0), m_BytesWritten(0), m_isGood(true) {}
+
+inline LogWriter::~LogWriter() {
+    Close();
+}
+
+inline bool LogWriter::Open(const std::string& path, const LogHeader& header) {
+    Close();
+    m_pFile = std::fopen(path.c_str(), "wb");
+    if (m_pFile == 0) {
+        return false;
+    }
+    //the buffer here is the only one, stdio's own would just be a second copy
+    std::setvbuf(m_pFile, 0, _IONBF, 0);
+    m_Used = 0;
+    m_BytesWritten = 0;
+    m_isGood = true;
+    header.Encode(&m_Buffer[0]);
+    m_Used = LogHeader::SIZE;
+    m_BytesWritten = LogHeader::SIZE;
+    return true;
+}
+
+inline unsigned char* LogWriter::Reserve() {
+    if (m_Used + RoundRecord::MAX_BYTES > BUFFER_SIZE) {
+        Flush();
+    }
+    return &m_Buffer[m_Used];
+}
+
+inline void LogWriter::Commit(int size) {
+    m_Used += size;
+    m_BytesWritten += size;
+}
+
+inline void LogWriter::Flush() {
+    if (m_pFile != 0 && m_Used > 0) {
+        m_isGood = (std::fwrite(&m_Buffer[0], 1, m_Used, m_pFile) == static_cast<std::size_t>(m_Used)) && m_isGood;
+    }
+    m_Used = 0;
+}
+
+inline bool LogWriter::Close() {
+    if (m_pFile == 0) {
+        return m_isGood;
+    }
+    Flush();
+    m_isGood = (std::fclose(m_pFile) == 0) && m_isGood;
+    m_pFile = 0;
+    return m_isGood;
+}
+
+inline long long LogWriter::GetBytesWritten() const {
+    return m_BytesWritten;
+}
+
+//memory maps a log and finds any round in it without reading the rounds before it: the offset of
+//every INDEX_STRIDE-th round is noted once when the log is opened, which only has to hop over
+//length bytes, and a lookup hops at most INDEX_STRIDE - 1 more
+class LogReader {
+    public:
+        static const int INDEX_STRIDE = 1024;
+
+        LogReader();
+        ~LogReader();
+        //maps the file and indexes it; returns false if it can't be read or isn't a log.
+        //a round cut short at the end of the file (a recorder that was stopped) is ignored
+        bool Open(const std::string& path);
+        void Close();
+        const LogHeader& GetHeader() const;
+        //the number of whole rounds in the log
+        long long size() const;
+        //the encoded bytes of the given round and how many there are
+        const unsigned char* GetRound(long long index, int& size) const;
+    private:
+        LogReader(const LogReader&);
+        LogReader& operator=(const LogReader&);
+
+        const unsigned char* m_pData;
+        std::size_t m_Size;
+        LogHeader m_Header;
+        long long m_NumRounds;
+        std::vector<std::size_t> m_Index;
+};
+
+inline LogReader::LogReader(): m_pData(0), m_Size(0), m_NumRounds(0) {}
+
+inline LogReader::~LogReader() {
+    Close();
+}
+
+inline bool LogReader::Open(const std::string& path) {
+    Close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < LogHeader::SIZE) {
+        ::close(fd);
+        return false;
+    }
+    void* pMapped = ::mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //the mapping keeps the file open by itself
+    ::close(fd);
+    if (pMapped == MAP_FAILED) {
+        return false;
+    }
+    m_pData = static_cast<const unsigned char*>(pMapped);
+    m_Size = info.st_size;
+    if (!m_Header.Decode(m_pData)) {
+        Close();
+        return false;
+    }
+    //the whole file is about to be walked front to back
+    ::madvise(pMapped, m_Size, MADV_SEQUENTIAL);
+    std::size_t at = LogHeader::SIZE;
+    while (at < m_Size && at + 1 + m_pData[at] <= m_Size) {
+        if (m_NumRounds % INDEX_STRIDE == 0) {
+            m_Index.push_back(at);
+        }
+        at += 1 + m_pData[at];
+        ++m_NumRounds;
+    }
+    ::madvise(pMapped, m_Size, MADV_RANDOM);
+    return true;
+}
+
+inline void LogReader::Close() {
+    if (m_pData != 0) {
+        ::munmap(const_cast<unsigned char*>(m_pData), m_Size);
+    }
+    m_pData = 0;
+    m_Size = 0;
+    m_NumRounds = 0;
+    m_Index.clear();
+}
+
+inline const LogHeader& LogReader::GetHeader() const {
+    return m_Header;
+}
+
+inline long long LogReader::size() const {
+    return m_NumRounds;
+}
+
+inline const unsigned char* LogReader::GetRound(long long index, int& size) const {
+    std::size_t at = m_Index[index / INDEX_STRIDE];
+    for (long long i = 0; i < index % INDEX_STRIDE; ++i) {
+        at += 1 + m_pData[at];
+    }
+    size = 1 + m_pData[at];
+    return m_pData + at;
+}
+
+//watches a table and records each round as it is played, passing every event on to another
+//observer so the table is shown (or counted) exactly as it would be without the recorder.
+//finished rounds go to a LogWriter if one is given, and the last one can be read back either way.
+//a record holds hits and stands only, so a recorded table plays the book's rules
+class RoundRecorder : public TableObserver {
+    public:
+        RoundRecorder(TableObserver& next, LogWriter* pWriter = 0);
+        virtual void Reshuffle();
+        virtual void ShowTable(const std::vector<GenericPlayer*>& players, const House& house);
+        virtual void StartTurn(const GenericPlayer& aGenericPlayer);
+        virtual void ShowHit(const GenericPlayer& aGenericPlayer);
+        virtual void Bust(const GenericPlayer& aGenericPlayer);
+        virtual void RevealHouse(const House& house);
+        virtual void Win(const GenericPlayer& aPlayer);
+        virtual void Lose(const GenericPlayer& aPlayer);
+        virtual void Push(const GenericPlayer& aPlayer);
+        //the last round to finish, until the next one is dealt
+        const RoundRecord& GetLastRound() const;
+    private:
+        //a player's turn ends either in a bust or in a decision to stand, which the observer never
+        //sees directly; so when the next turn starts, a player who didn't bust must have stood
+        void EndTurn();
+        void AddResult(RoundRecord::Result result);
+
+        TableObserver* m_pNext;
+        LogWriter* m_pWriter;
+        RoundRecord m_Round;
+        int m_NumSeats;
+        const House* m_pHouse;
+        const GenericPlayer* m_pTurn;
+        bool m_isShuffled;
+};
+
+inline RoundRecorder::RoundRecorder(TableObserver& next, LogWriter* pWriter):
+    m_pNext(&next),
+    m_pWriter(pWriter),
+    m_NumSeats(0),
+    m_pHouse(0),
+    m_pTurn(0),
+    m_isShuffled(false)
+{}
+
+inline void RoundRecorder::Reshuffle() {
+    m_isShuffled = true;
+    m_pNext->Reshuffle();
+}
+
+inline void RoundRecorder::ShowTable(const std::vector<GenericPlayer*>& players, const House& house) {
+    //everyone has been dealt two cards, a card to each player then the house, twice over
+    m_Round.Clear();
+    m_Round.shuffled = m_isShuffled;
+    m_isShuffled = false;
+    for (int i = 0; i < 2; ++i) {
+        for (std::size_t p = 0; p < players.size(); ++p) {
+            m_Round.AddCard(players[p]->GetCard(i));
+        }
+        m_Round.AddCard(house.GetCard(i));
+    }
+    m_NumSeats = static_cast<int>(players.size());
+    m_pHouse = &house;
+    m_pTurn = 0;
+    m_pNext->ShowTable(players, house);
+}
+
+inline void RoundRecorder::StartTurn(const GenericPlayer& aGenericPlayer) {
+    EndTurn();
+    if (&aGenericPlayer != m_pHouse) {
+        m_pTurn = &aGenericPlayer;
+    }
+    m_pNext->StartTurn(aGenericPlayer);
+}
+
+inline void RoundRecorder::ShowHit(const GenericPlayer& aGenericPlayer) {
+    m_Round.AddCard(aGenericPlayer.GetCard(aGenericPlayer.size() - 1));
+    if (&aGenericPlayer == m_pTurn) {
+        m_Round.AddDecision(true);
+    }
+    m_pNext->ShowHit(aGenericPlayer);
+}
+
+inline void RoundRecorder::Bust(const GenericPlayer& aGenericPlayer) {
+    m_pNext->Bust(aGenericPlayer);
+}
+
+inline void RoundRecorder::RevealHouse(const House& house) {
+    EndTurn();
+    m_pNext->RevealHouse(house);
+}
+
+inline void RoundRecorder::EndTurn() {
+    if (m_pTurn != 0 && !m_pTurn->isBusted()) {
+        m_Round.AddDecision(false);
+    }
+    m_pTurn = 0;
+}
+
+inline void RoundRecorder::Win(const GenericPlayer& aPlayer) {
+    m_pNext->Win(aPlayer);
+    AddResult(RoundRecord::WIN);
+}
+
+inline void RoundRecorder::Lose(const GenericPlayer& aPlayer) {
+    m_pNext->Lose(aPlayer);
+    AddResult(RoundRecord::LOSE);
+}
+
+inline void RoundRecorder::Push(const GenericPlayer& aPlayer) {
+    m_pNext->Push(aPlayer);
+    AddResult(RoundRecord::PUSH);
+}
+
+inline void RoundRecorder::AddResult(RoundRecord::Result result) {
+    //results come in seat order, and the last one ends the round
+    m_Round.results[m_Round.numPlayers] = static_cast<unsigned char>(result);
+    ++m_Round.numPlayers;
+    if (m_Round.numPlayers == m_NumSeats && m_pWriter != 0) {
+        //encoded straight into the writer's buffer, with no copy in between
+        m_pWriter->Commit(m_Round.Encode(m_pWriter->Reserve()));
+    }
+}
+
+inline const RoundRecord& RoundRecorder::GetLastRound() const {
+    return m_Round;
+}
+
+//hands out a logged round's decisions one at a time, in the order they were made
+struct DecisionCursor {
+    const RoundRecord* pRound;
+    int next;
+
+    DecisionCursor();
+    //the next decision, or stand once the round has none left
+    bool Next();
+};
+
+inline DecisionCursor::DecisionCursor(): pRound(0), next(0) {}
+
+inline bool DecisionCursor::Next() {
+    if (pRound == 0 || next >= pRound->numDecisions) {
+        return false;
+    }
+    return pRound->GetDecision(next++);
+}
+
+//a player that makes the decisions of a logged round; every ReplayPlayer at a table shares one
+//cursor, as the game asks the players in turn and the log has their decisions in that order
+class ReplayPlayer : public GenericPlayer {
+    public:
+        ReplayPlayer(DecisionCursor& cursor, const std::string& name);
+        virtual ~ReplayPlayer();
+        virtual bool isHitting() const;
+    private:
+        DecisionCursor* m_pCursor;
+};
+
+inline ReplayPlayer::ReplayPlayer(DecisionCursor& cursor, const std::string& name):
+    GenericPlayer(name),
+    m_pCursor(&cursor)
+{}
+
+inline ReplayPlayer::~ReplayPlayer() {}
+
+inline bool ReplayPlayer::isHitting() const {
+    return m_pCursor->Next();
+}
+
+//plays logged rounds again through a real Game: the shoe is stacked with the round's cards,
+//ReplayPlayers make its decisions and a RoundRecorder records the result, which has to come out
+//byte for byte the same as the log. every event goes on to the given observer, so a replay can
+//be shown on the console exactly as the round would have been
+class RoundReplayer {
+    public:
+        RoundReplayer(const LogHeader& header, TableObserver& observer);
+        ~RoundReplayer();
+        //replays one encoded round, returning true if it played out exactly as logged
+        bool Replay(const unsigned char* bytes, int size);
+    private:
+        RoundReplayer(const RoundReplayer&);
+        RoundReplayer& operator=(const RoundReplayer&);
+
+        RoundRecorder m_Recorder;
+        Game m_Game;
+        DecisionCursor m_Cursor;
+        RoundRecord m_Round;
+        std::vector<ReplayPlayer*> m_Players;
+        int m_NumPlayers;
+        unsigned char m_Replayed[RoundRecord::MAX_BYTES];
+};
+
+inline RoundReplayer::RoundReplayer(const LogHeader& header, TableObserver& observer):
+    m_Recorder(observer),
+    m_Game(m_Recorder, header.numDecks, header.penetration),
+    m_NumPlayers(header.numPlayers)
+{
+    m_Cursor.pRound = &m_Round;
+    for (int i = 0; i < m_NumPlayers; ++i) {
+        m_Players.push_back(new ReplayPlayer(m_Cursor, "Seat " + std::to_string(i + 1)));
+        m_Game.AddPlayer(m_Players.back());
+    }
+}
+
+inline RoundReplayer::~RoundReplayer() {
+    std::vector<ReplayPlayer*>::iterator pPlayer;
+    for (pPlayer = m_Players.begin(); pPlayer != m_Players.end(); ++pPlayer) {
+        delete *pPlayer;
+        *pPlayer = 0;
+    }
+}
+
+inline bool RoundReplayer::Replay(const unsigned char* bytes, int size) {
+    if (!m_Round.Decode(bytes, size, m_NumPlayers) || !m_Game.Stack(m_Round.cards, m_Round.numCards)) {
+        return false;
+    }
+    m_Cursor.next = 0;
+    //the stacked shoe is full, so the game itself won't shuffle; show the shuffle the log recorded
+    if (m_Round.shuffled) {
+        m_Recorder.Reshuffle();
+    }
+    m_Game.Play();
+    int replayedSize = m_Recorder.GetLastRound().Encode(m_Replayed);
+    return (replayedSize == size && std::memcmp(m_Replayed, bytes, size) == 0);
+}
+
+#endif
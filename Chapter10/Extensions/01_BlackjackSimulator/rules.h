@@ -0,0 +1,120 @@
+//Rules
+//The optional table rules a Game can be played with: doubling, splitting, surrender and H17
+
+#ifndef BLACKJACK_RULES_H
+#define BLACKJACK_RULES_H
+
+#include <string>
+
+//what a table allows beyond hitting and standing. the defaults are the book's table, where a
+//player can only hit or stand and the house stands on all 17s
+struct TableRules {
+    //the most hands a split can leave a player with, split hands included: 1 means no splitting,
+    //2 a single split and 4 up to three re-splits
+    static const int MAX_HANDS_LIMIT = 4;
+
+    //the house hits soft 17 (H17) rather than standing on it (S17)
+    bool isHouseHittingSoft17;
+    //a player can double down on their first two cards
+    bool isDoubleAllowed;
+    //doubling is also allowed on the first two cards of a split hand
+    bool isDoubleAfterSplit;
+    int maxHands;
+    //a pair of aces dealt to a split ace can be split again
+    bool isResplitAcesAllowed;
+    //split aces can be hit; normally each gets one more card and no more
+    bool isHittingSplitAces;
+    //a player can give up their first two cards for half their bet back (late surrender)
+    bool isSurrenderAllowed;
+
+    TableRules();
+    //reads a comma separated list of rules to turn on: h17, double, das (double after split),
+    //split (one split), resplit (up to MAX_HANDS_LIMIT hands), rsa (re-split aces),
+    //hsa (hit split aces) and surrender; returns false, leaving the rules unchanged, if any
+    //name is unknown
+    bool Parse(const std::string& names);
+    //whether these are the book's rules, which every part of the simulator supports
+    bool isBookRules() const;
+    //the rules turned on, in the form Parse reads, or "book"
+    std::string GetNames() const;
+};
+
+inline TableRules::TableRules():
+    isHouseHittingSoft17(false),
+    isDoubleAllowed(false),
+    isDoubleAfterSplit(false),
+    maxHands(1),
+    isResplitAcesAllowed(false),
+    isHittingSplitAces(false),
+    isSurrenderAllowed(false)
+{}
+
+inline bool TableRules::Parse(const std::string& names) {
+    TableRules rules;
+    std::string::size_type start = 0;
+    while (start <= names.size()) {
+        std::string::size_type end = names.find(',', start);
+        end = (end == std::string::npos) ? names.size() : end;
+        std::string name = names.substr(start, end - start);
+        if (name == "h17") {
+            rules.isHouseHittingSoft17 = true;
+        }
+        else if (name == "double") {
+            rules.isDoubleAllowed = true;
+        }
+        else if (name == "das") {
+            rules.isDoubleAllowed = true;
+            rules.isDoubleAfterSplit = true;
+        }
+        else if (name == "split") {
+            rules.maxHands = (rules.maxHands > 2) ? rules.maxHands : 2;
+        }
+        else if (name == "resplit") {
+            rules.maxHands = MAX_HANDS_LIMIT;
+        }
+        else if (name == "rsa") {
+            rules.isResplitAcesAllowed = true;
+        }
+        else if (name == "hsa") {
+            rules.isHittingSplitAces = true;
+        }
+        else if (name == "surrender") {
+            rules.isSurrenderAllowed = true;
+        }
+        else if (name != "book") {
+            return false;
+        }
+        start = end + 1;
+    }
+    *this = rules;
+    return true;
+}
+
+inline bool TableRules::isBookRules() const {
+    return !isHouseHittingSoft17 && !isDoubleAllowed && maxHands == 1 && !isSurrenderAllowed;
+}
+
+inline std::string TableRules::GetNames() const {
+    std::string names;
+    if (isHouseHittingSoft17) {
+        names += ",h17";
+    }
+    if (isDoubleAllowed) {
+        names += isDoubleAfterSplit ? ",das" : ",double";
+    }
+    if (maxHands > 1) {
+        names += (maxHands > 2) ? ",resplit" : ",split";
+    }
+    if (isResplitAcesAllowed) {
+        names += ",rsa";
+    }
+    if (isHittingSplitAces) {
+        names += ",hsa";
+    }
+    if (isSurrenderAllowed) {
+        names += ",surrender";
+    }
+    return names.empty() ? "book" : names.substr(1);
+}
+
+#endif
@@ -0,0 +1,351 @@
+//Simulator
+//Plays Blackjack rounds at volume with no console input or output
+
+#ifndef BLACKJACK_SIMULATOR_H
+#define BLACKJACK_SIMULATOR_H
+
+#include <string>
+#include <vector>
+
+#include "bankroll.h"
+#include "game.h"
+#include "hand.h"
+#include "rules.h"
+#include "strategy.h"
+
+//a hit/stand decision: given the player's total, whether it is soft and the house's up card value
+typedef bool (*HitDecision)(int total, bool isSoft, int houseUpValue);
+
+//hits the same way the house does, on 16 or less
+inline bool hitLikeHouse(int total, bool, int) {
+    return (total <= 16);
+}
+
+//never takes a card
+inline bool hitNever(int, bool, int) {
+    return false;
+}
+
+//a simplified basic strategy: always hit 11 or less and soft 17 or less,
+//hit hard 12-16 only while the house shows a 7 or better
+inline bool hitSimple(int total, bool isSoft, int houseUpValue) {
+    if (total <= 11 || (isSoft && total <= 17)) {
+        return true;
+    }
+    if (total <= 16) {
+        return (houseUpValue >= 7 || houseUpValue == Card::ACE);
+    }
+    return false;
+}
+
+//a decision under a table's rules: given the hand, the house's up card value and the decisions
+//allowed (1 << decision for each), what to do
+typedef GenericPlayer::Decision (*PlayDecision)(const Hand& aHand, int houseUpValue, unsigned int allowed);
+
+//hitSimple, plus the textbook uses of the other decisions when they are allowed: surrender hard
+//15 and 16 against a 10 or ace, always split aces and 8s, and double 10 and 11 against a lower
+//up card
+inline GenericPlayer::Decision playSimple(const Hand& aHand, int houseUpValue, unsigned int allowed) {
+    int total = aHand.GetTotal();
+    bool isHighUp = (houseUpValue == 10 || houseUpValue == Card::ACE);
+    if ((allowed & (1u << GenericPlayer::SURRENDER)) && !aHand.isSoft() && (total == 15 || total == 16) && isHighUp) {
+        return GenericPlayer::SURRENDER;
+    }
+    if ((allowed & (1u << GenericPlayer::SPLIT)) &&
+        (aHand.GetCard(0).GetValue() == Card::ACE || aHand.GetCard(0).GetValue() == 8)) {
+        return GenericPlayer::SPLIT;
+    }
+    if ((allowed & (1u << GenericPlayer::DOUBLE)) && !aHand.isSoft() && (total == 10 || total == 11) &&
+        houseUpValue != Card::ACE && houseUpValue < total) {
+        return GenericPlayer::DOUBLE;
+    }
+    if ((allowed & (1u << GenericPlayer::HIT)) && hitSimple(total, aHand.isSoft(), houseUpValue)) {
+        return GenericPlayer::HIT;
+    }
+    return GenericPlayer::STAND;
+}
+
+//a player whose decisions come from a HitDecision or a PlayDecision instead of the console
+class SimPlayer : public GenericPlayer {
+    public:
+        SimPlayer(HitDecision decide, const House& house, const std::string& name = "Sim");
+        SimPlayer(PlayDecision play, const House& house, const std::string& name = "Sim");
+        virtual ~SimPlayer();
+        virtual bool isHitting() const;
+        virtual Decision Decide(const Hand& aHand, unsigned int allowed) const;
+    private:
+        HitDecision m_Decide;
+        PlayDecision m_Play;
+        const House* m_pHouse;
+};
+
+inline SimPlayer::SimPlayer(HitDecision decide, const House& house, const std::string& name):
+    GenericPlayer(name),
+    m_Decide(decide),
+    m_Play(0),
+    m_pHouse(&house)
+{}
+
+inline SimPlayer::SimPlayer(PlayDecision play, const House& house, const std::string& name):
+    GenericPlayer(name),
+    m_Decide(0),
+    m_Play(play),
+    m_pHouse(&house)
+{}
+
+inline SimPlayer::~SimPlayer() {}
+
+inline bool SimPlayer::isHitting() const {
+    if (m_Play != 0) {
+        return (m_Play(*this, m_pHouse->GetUpCardValue(), (1u << HIT) | (1u << STAND)) == HIT);
+    }
+    return m_Decide(GetTotal(), isSoft(), m_pHouse->GetUpCardValue());
+}
+
+inline GenericPlayer::Decision SimPlayer::Decide(const Hand& aHand, unsigned int allowed) const {
+    if (m_Play != 0) {
+        return m_Play(aHand, m_pHouse->GetUpCardValue(), allowed);
+    }
+    return m_Decide(aHand.GetTotal(), aHand.isSoft(), m_pHouse->GetUpCardValue()) ? HIT : STAND;
+}
+
+//outcome counters for a run, every player hand (split hands included) counts once per round
+struct SimStats {
+    long long rounds;
+    long long hands;
+    long long wins;
+    long long losses;
+    long long pushes;
+    long long playerBusts;
+    long long houseBusts;
+    //decisions beyond hit and stand, under rules that allow them; a surrendered hand has no
+    //other outcome
+    long long doubles;
+    long long splits;
+    long long surrenders;
+    //units staked, a doubled hand staking 2, and the players' net winnings in units
+    long long wagered;
+    double net;
+    //every round's combined result for the whole table
+    BankrollStats bankroll;
+
+    SimStats();
+    //adds another run's counts to these
+    void Merge(const SimStats& other);
+    //net units won by the house per unit wagered, every outcome pays even money
+    double HouseEdge() const;
+};
+
+inline SimStats::SimStats():
+    rounds(0), hands(0), wins(0), losses(0), pushes(0), playerBusts(0), houseBusts(0),
+    doubles(0), splits(0), surrenders(0), wagered(0), net(0.0)
+{}
+
+inline void SimStats::Merge(const SimStats& other) {
+    rounds += other.rounds;
+    hands += other.hands;
+    wins += other.wins;
+    losses += other.losses;
+    pushes += other.pushes;
+    playerBusts += other.playerBusts;
+    houseBusts += other.houseBusts;
+    doubles += other.doubles;
+    splits += other.splits;
+    surrenders += other.surrenders;
+    wagered += other.wagered;
+    net += other.net;
+    bankroll.Merge(other.bankroll);
+}
+
+inline double SimStats::HouseEdge() const {
+    if (wagered == 0) {
+        return 0.0;
+    }
+    return -net / wagered;
+}
+
+//a silent table that only counts outcomes
+class CountingObserver : public TableObserver {
+    public:
+        CountingObserver();
+        virtual void RevealHouse(const House& house);
+        virtual void Bust(const GenericPlayer& aGenericPlayer);
+        virtual void DoubleDown(const GenericPlayer& aHand);
+        virtual void Split(const GenericPlayer& aHand, const GenericPlayer& newHand);
+        virtual void Surrender(const GenericPlayer& aHand);
+        virtual void Win(const GenericPlayer& aPlayer);
+        virtual void Lose(const GenericPlayer& aPlayer);
+        virtual void Push(const GenericPlayer& aPlayer);
+        virtual void EndRound();
+        const SimStats& GetStats() const;
+        SimStats& GetStats();
+    private:
+        SimStats m_Stats;
+        const House* m_pHouse;
+        //the table's result so far this round, one outcome at a time
+        double m_RoundNet;
+};
+
+inline CountingObserver::CountingObserver(): m_pHouse(0), m_RoundNet(0.0) {}
+
+inline void CountingObserver::RevealHouse(const House& house) {
+    //the house reveals before it draws, so any later bust can be recognised as the house's
+    m_pHouse = &house;
+}
+
+inline void CountingObserver::Bust(const GenericPlayer& aGenericPlayer) {
+    //player busts are counted with their loss
+    if (&aGenericPlayer == m_pHouse) {
+        ++m_Stats.houseBusts;
+    }
+}
+
+inline void CountingObserver::DoubleDown(const GenericPlayer&) {
+    ++m_Stats.doubles;
+}
+
+inline void CountingObserver::Split(const GenericPlayer&, const GenericPlayer&) {
+    ++m_Stats.splits;
+}
+
+inline void CountingObserver::Surrender(const GenericPlayer&) {
+    //half the unit staked is given back
+    ++m_Stats.hands;
+    ++m_Stats.surrenders;
+    ++m_Stats.wagered;
+    m_Stats.net -= 0.5;
+    m_RoundNet -= 0.5;
+}
+
+inline void CountingObserver::Win(const GenericPlayer& aPlayer) {
+    ++m_Stats.hands;
+    ++m_Stats.wins;
+    m_Stats.wagered += aPlayer.GetStake();
+    m_Stats.net += aPlayer.GetStake();
+    m_RoundNet += aPlayer.GetStake();
+}
+
+inline void CountingObserver::Lose(const GenericPlayer& aPlayer) {
+    ++m_Stats.hands;
+    ++m_Stats.losses;
+    if (aPlayer.isBusted()) {
+        ++m_Stats.playerBusts;
+    }
+    m_Stats.wagered += aPlayer.GetStake();
+    m_Stats.net -= aPlayer.GetStake();
+    m_RoundNet -= aPlayer.GetStake();
+}
+
+inline void CountingObserver::Push(const GenericPlayer& aPlayer) {
+    ++m_Stats.hands;
+    ++m_Stats.pushes;
+    m_Stats.wagered += aPlayer.GetStake();
+}
+
+inline void CountingObserver::EndRound() {
+    m_Stats.bankroll.Add(m_RoundNet);
+    m_RoundNet = 0.0;
+}
+
+inline const SimStats& CountingObserver::GetStats() const {
+    return m_Stats;
+}
+
+inline SimStats& CountingObserver::GetStats() {
+    return m_Stats;
+}
+
+//how a simulated table is set up
+struct SimConfig {
+    //seats at the table, 1-7
+    int numPlayers;
+    //decks in the shoe, 1 to Deck::MAX_DECKS
+    int numDecks;
+    //fraction of the shoe dealt before the cut card comes out
+    double penetration;
+    unsigned int seed;
+    //which of the seed's non-overlapping random streams the shoe draws from
+    int stream;
+    //what the table allows; only a Simulator (rather than a PolicySimulator) plays other than
+    //the book's rules
+    TableRules rules;
+
+    SimConfig();
+};
+
+inline SimConfig::SimConfig(): numPlayers(1), numDecks(6), penetration(0.75), seed(1), stream(0) {}
+
+//owns a silent Game and a table of players all sharing one decision rule
+class Simulator {
+    public:
+        typedef SimStats Stats;
+
+        //seats SimPlayers deciding with the given function
+        Simulator(HitDecision decide, const SimConfig& config);
+        Simulator(PlayDecision play, const SimConfig& config);
+        //seats StrategyPlayers following the given table, which must outlive the simulator
+        Simulator(const BasicStrategy& strategy, const SimConfig& config);
+        ~Simulator();
+        //plays the given number of rounds
+        void Run(long long rounds);
+        const SimStats& GetStats() const;
+    private:
+        Simulator(const Simulator&);
+        Simulator& operator=(const Simulator&);
+
+        CountingObserver m_Observer;
+        Game m_Game;
+        std::vector<GenericPlayer*> m_Players;
+};
+
+inline Simulator::Simulator(HitDecision decide, const SimConfig& config):
+    m_Game(m_Observer, config.numDecks, config.penetration, config.rules)
+{
+    m_Game.Seed(config.seed, config.stream);
+    for (int i = 0; i < config.numPlayers; ++i) {
+        m_Players.push_back(new SimPlayer(decide, m_Game.GetHouse()));
+        m_Game.AddPlayer(m_Players.back());
+    }
+}
+
+inline Simulator::Simulator(PlayDecision play, const SimConfig& config):
+    m_Game(m_Observer, config.numDecks, config.penetration, config.rules)
+{
+    m_Game.Seed(config.seed, config.stream);
+    for (int i = 0; i < config.numPlayers; ++i) {
+        m_Players.push_back(new SimPlayer(play, m_Game.GetHouse()));
+        m_Game.AddPlayer(m_Players.back());
+    }
+}
+
+inline Simulator::Simulator(const BasicStrategy& strategy, const SimConfig& config):
+    m_Game(m_Observer, config.numDecks, config.penetration, config.rules)
+{
+    m_Game.Seed(config.seed, config.stream);
+    for (int i = 0; i < config.numPlayers; ++i) {
+        m_Players.push_back(new StrategyPlayer(strategy, m_Game.GetHouse()));
+        m_Game.AddPlayer(m_Players.back());
+    }
+}
+
+inline Simulator::~Simulator() {
+    std::vector<GenericPlayer*>::iterator pPlayer;
+    for (pPlayer = m_Players.begin(); pPlayer != m_Players.end(); ++pPlayer) {
+        delete *pPlayer;
+        *pPlayer = 0;
+    }
+}
+
+inline void Simulator::Run(long long rounds) {
+    for (long long i = 0; i < rounds; ++i) {
+        m_Game.Play();
+    }
+    //hands are counted as they finish, as a split can give a seat more than one
+    m_Observer.GetStats().rounds += rounds;
+}
+
+inline const SimStats& Simulator::GetStats() const {
+    return m_Observer.GetStats();
+}
+
+#endif
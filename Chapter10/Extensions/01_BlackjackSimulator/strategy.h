@@ -0,0 +1,161 @@
+//Strategy
+//Works out the best hit/stand play for every hand and seats a player that follows it
+
+#ifndef BLACKJACK_STRATEGY_H
+#define BLACKJACK_STRATEGY_H
+
+#include <string>
+
+#include "dealerOdds.h"
+#include "deck.h"
+#include "hand.h"
+
+//the best play for every (player total, soft or hard, house up card), worked out once by dynamic
+//programming over the exact dealer odds and then looked up with a single array index
+class BasicStrategy {
+    public:
+        //totals 0-21, soft and hard, up cards 0-10 (1 for an ace, 0 for no up card yet)
+        static const int NUM_TOTALS = 22;
+        static const int NUM_UP_CARDS = 11;
+        static const int TABLE_SIZE = 2 * NUM_TOTALS * NUM_UP_CARDS;
+
+        //a table that always stands, until Generate is called
+        BasicStrategy();
+        //solves every hand against every up card for a fresh shoe of numDecks decks, against a
+        //house that stands on or hits soft 17 as odds does
+        void Generate(int numDecks, DealerOdds& odds);
+        //returns whether the best play for the hand is to hit
+        bool isHitting(int total, bool isSoft, int upCardValue) const;
+        //the player's expected winnings per unit bet when playing the hand from here on
+        double GetValue(int total, bool isSoft, int upCardValue) const;
+        //the player's expected winnings per unit bet for a whole round played by this table,
+        //counting the shoe as fresh for every card (so ignoring the effect of removed cards)
+        double GetExpectedValue() const;
+    private:
+        static int Index(int total, bool isSoft, int upCardValue);
+
+        unsigned char m_Hit[TABLE_SIZE];
+        double m_Value[TABLE_SIZE];
+        double m_ExpectedValue;
+};
+
+inline BasicStrategy::BasicStrategy(): m_ExpectedValue(0.0) {
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        m_Hit[i] = 0;
+        m_Value[i] = 0.0;
+    }
+}
+
+inline int BasicStrategy::Index(int total, bool isSoft, int upCardValue) {
+    return ((isSoft ? NUM_TOTALS : 0) + total) * NUM_UP_CARDS + upCardValue;
+}
+
+inline bool BasicStrategy::isHitting(int total, bool isSoft, int upCardValue) const {
+    return m_Hit[Index(total, isSoft, upCardValue)] != 0;
+}
+
+inline double BasicStrategy::GetValue(int total, bool isSoft, int upCardValue) const {
+    return m_Value[Index(total, isSoft, upCardValue)];
+}
+
+inline double BasicStrategy::GetExpectedValue() const {
+    return m_ExpectedValue;
+}
+
+inline void BasicStrategy::Generate(int numDecks, DealerOdds& odds) {
+    //player hands are summed up by their hard total (2-31, anything over 21 is bust) and whether
+    //they hold an ace; every card can only raise the hard total, so filling the table from the
+    //highest hard total down means every hand's hits have been solved before the hand itself
+    const int MAX_HARD = 32;
+    ShoeCounts full = ShoeCounts::Full(numDecks);
+    m_ExpectedValue = 0.0;
+
+    for (int up = Card::ACE; up <= 10; ++up) {
+        ShoeCounts shoe = full;
+        shoe.Remove(up);
+        DealerOutcome dealer = odds.FromUpCard(shoe, up);
+
+        //standing on a total wins if the house busts or finishes lower, and loses if it finishes
+        //higher; the house always finishes on 17 or more, so standing lower only wins on a bust
+        double stand[NUM_TOTALS];
+        for (int total = 0; total < NUM_TOTALS; ++total) {
+            double win = dealer.Bust();
+            double lose = 0.0;
+            for (int d = 17; d <= 21; ++d) {
+                if (d < total) {
+                    win += dealer.Total(d);
+                }
+                else if (d > total) {
+                    lose += dealer.Total(d);
+                }
+            }
+            stand[total] = win - lose;
+        }
+
+        double best[MAX_HARD][2];
+        for (int hard = MAX_HARD - 1; hard >= 0; --hard) {
+            for (int ace = 0; ace < 2; ++ace) {
+                bool isSoft = (ace == 1 && hard <= 11);
+                int total = isSoft ? hard + 10 : hard;
+                if (total > 21) {
+                    best[hard][ace] = -1.0;
+                    continue;
+                }
+                double hit = 0.0;
+                for (int v = Card::ACE; v <= 10; ++v) {
+                    double chance = static_cast<double>(shoe.count[v]) / shoe.total;
+                    int next = hard + v < MAX_HARD ? hard + v : MAX_HARD - 1;
+                    hit += chance * best[next][(ace == 1 || v == Card::ACE) ? 1 : 0];
+                }
+                bool hitting = hit > stand[total];
+                best[hard][ace] = hitting ? hit : stand[total];
+                //a hard hand holding an ace plays just like one without, so fill each entry once
+                if (isSoft || ace == 0) {
+                    m_Hit[Index(total, isSoft, up)] = hitting ? 1 : 0;
+                    m_Value[Index(total, isSoft, up)] = best[hard][ace];
+                }
+            }
+        }
+
+        //weight this up card's two card starting hands by their chance of being dealt
+        double upChance = static_cast<double>(full.count[up]) / full.total;
+        for (int first = Card::ACE; first <= 10; ++first) {
+            for (int second = Card::ACE; second <= 10; ++second) {
+                double chance = static_cast<double>(shoe.count[first]) / shoe.total;
+                chance *= static_cast<double>(shoe.count[second]) / shoe.total;
+                bool ace = (first == Card::ACE || second == Card::ACE);
+                m_ExpectedValue += upChance * chance * best[first + second][ace ? 1 : 0];
+            }
+        }
+    }
+    //with no up card showing there is nothing to go on, so play like the house
+    for (int total = 0; total < NUM_TOTALS; ++total) {
+        m_Hit[Index(total, false, 0)] = (total <= 16) ? 1 : 0;
+        m_Hit[Index(total, true, 0)] = (total <= 16 || (total == 17 && odds.isHittingSoft17())) ? 1 : 0;
+    }
+}
+
+//a player that plays a BasicStrategy table
+class StrategyPlayer : public GenericPlayer {
+    public:
+        StrategyPlayer(const BasicStrategy& strategy, const House& house, const std::string& name = "Basic");
+        virtual ~StrategyPlayer();
+        virtual bool isHitting() const;
+    private:
+        const BasicStrategy* m_pStrategy;
+        const House* m_pHouse;
+};
+
+inline StrategyPlayer::StrategyPlayer(const BasicStrategy& strategy, const House& house, const std::string& name):
+    GenericPlayer(name),
+    m_pStrategy(&strategy),
+    m_pHouse(&house)
+{}
+
+inline StrategyPlayer::~StrategyPlayer() {}
+
+inline bool StrategyPlayer::isHitting() const {
+    return m_pStrategy->isHitting(GetTotal(), isSoft(), m_pHouse->GetUpCardValue());
+}
+
+#endif
@@ -0,0 +1,508 @@
+//Table Server
+//Thousands of tables, each a Game played in steps, served over a Unix domain socket by a fixed
+//pool of worker threads
+
+#ifndef BLACKJACK_TABLESERVER_H
+#define BLACKJACK_TABLESERVER_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "hand.h"
+#include "render.h"
+
+//the protocol is one line of text per request and one line per reply, so it can be played by
+//hand with a tool like socat:
+//    N        opens a new table on this connection    -> "<table> open"
+//    D <t>    deals a round at table t               -> "<t> play <total> <cards> / <house cards>"
+//    H <t>    hits                                   -> the same, or the result of the round
+//    S <t>    stands                                 -> "<t> win|lose|push <total> <cards> / <house cards>"
+//a request that can't be carried out is answered "<t> error <reason>" (or "error <reason>" if
+//the line names no table). every request gets exactly one reply, in the order they were sent
+
+//the player sitting at a server table; their decisions arrive over the socket, so the game is
+//always played in steps and never asks
+class RemotePlayer : public GenericPlayer {
+    public:
+        RemotePlayer(const std::string& name = "Player");
+        virtual ~RemotePlayer();
+        virtual bool isHitting() const;
+};
+
+inline RemotePlayer::RemotePlayer(const std::string& name): GenericPlayer(name) {}
+
+inline RemotePlayer::~RemotePlayer() {}
+
+inline bool RemotePlayer::isHitting() const {
+    return false;
+}
+
+//one player's table; it watches its own game so it can describe the hands when the round ends,
+//before the game clears them away
+class ServerTable : public TableObserver {
+    public:
+        ServerTable(int id, std::uint64_t seed, int numDecks, double penetration);
+        //carries out one action, 'D' (deal), 'H' (hit) or 'S' (stand), and appends the reply
+        void Act(char action, std::string& reply);
+        virtual void Win(const GenericPlayer& aPlayer);
+        virtual void Lose(const GenericPlayer& aPlayer);
+        virtual void Push(const GenericPlayer& aPlayer);
+    private:
+        //"<id> <state> <total> <cards> / <house cards>"
+        void AddState(const char* state, std::string& reply) const;
+        void AddError(const char* reason, std::string& reply) const;
+
+        int m_Id;
+        RemotePlayer m_Player;
+        Game m_Game;
+        //where the current action's reply goes, and whether the round's result has filled it
+        std::string* m_pReply;
+        bool m_isReplied;
+};
+
+inline ServerTable::ServerTable(int id, std::uint64_t seed, int numDecks, double penetration):
+    m_Id(id),
+    m_Game(*this, numDecks, penetration),
+    m_pReply(0),
+    m_isReplied(false)
+{
+    m_Game.Seed(seed);
+    m_Game.AddPlayer(&m_Player);
+}
+
+inline void ServerTable::Act(char action, std::string& reply) {
+    m_pReply = &reply;
+    m_isReplied = false;
+    if (action == 'D') {
+        if (m_Game.isRoundInProgress()) {
+            AddError("round in progress", reply);
+            return;
+        }
+        m_Game.StartRound();
+    }
+    else if (!m_Game.isRoundInProgress()) {
+        AddError("no round in progress", reply);
+        return;
+    }
+    else if (action == 'H') {
+        m_Game.Hit();
+    }
+    else {
+        m_Game.Stand();
+    }
+    //the round is still waiting on the player unless it just ended with a result
+    if (!m_isReplied) {
+        AddState("play", reply);
+    }
+}
+
+inline void ServerTable::Win(const GenericPlayer&) {
+    AddState("win", *m_pReply);
+    m_isReplied = true;
+}
+
+inline void ServerTable::Lose(const GenericPlayer&) {
+    AddState("lose", *m_pReply);
+    m_isReplied = true;
+}
+
+inline void ServerTable::Push(const GenericPlayer&) {
+    AddState("push", *m_pReply);
+    m_isReplied = true;
+}
+
+inline void ServerTable::AddState(const char* state, std::string& reply) const {
+    appendNumber(reply, m_Id);
+    reply += ' ';
+    reply += state;
+    reply += ' ';
+    appendNumber(reply, m_Player.GetTotal());
+    for (int i = 0; i < m_Player.size(); ++i) {
+        reply += ' ';
+        reply += m_Player.GetCard(i).GetText();
+    }
+    reply += " /";
+    const House& house = m_Game.GetHouse();
+    for (int i = 0; i < house.size(); ++i) {
+        reply += ' ';
+        reply += house.GetCard(i).GetText();
+    }
+    reply += '\n';
+}
+
+inline void ServerTable::AddError(const char* reason, std::string& reply) const {
+    appendNumber(reply, m_Id);
+    reply += " error ";
+    reply += reason;
+    reply += '\n';
+}
+
+struct ServerConfig {
+    std::string path;
+    int numWorkers;
+    int numDecks;
+    double penetration;
+    std::uint64_t seed;
+
+    ServerConfig();
+};
+
+inline ServerConfig::ServerConfig(): numWorkers(1), numDecks(6), penetration(0.75), seed(0) {}
+
+//every worker thread runs its own epoll loop. a connection belongs to whichever worker accepted
+//it and a table to the connection that opened it, so a table is only ever touched by one thread
+//and nothing needs a lock
+class TableServer {
+    public:
+        //requests longer than this are refused and the connection closed
+        static const int MAX_LINE = 64;
+        static const int MAX_TABLES_PER_CONNECTION = 1 << 16;
+
+        TableServer(const ServerConfig& config);
+        ~TableServer();
+        //creates the socket (replacing a stale one at the same path); returns false, with errno
+        //set, if it can't
+        bool Listen();
+        //runs the worker pool until Stop is called from another thread
+        void Run();
+        void Stop();
+        //totals over every worker, valid once Run has returned
+        long long GetConnections() const;
+        long long GetTables() const;
+        long long GetRequests() const;
+    private:
+        struct Connection {
+            int fd;
+            std::string in;
+            std::string out;
+            std::size_t numSent;
+            //whether the connection is waiting to send rather than to read
+            bool isWriting;
+            std::vector<ServerTable*> tables;
+        };
+
+        struct Worker {
+            int index;
+            int epollFd;
+            //connections by file descriptor, which are small and never shared between workers
+            std::vector<Connection*> connections;
+            long long numConnections;
+            long long numTables;
+            long long numRequests;
+        };
+
+        void Serve(Worker& worker);
+        void Accept(Worker& worker);
+        //reads what has arrived and answers every complete line; returns false once the
+        //connection has been closed
+        bool Read(Worker& worker, Connection& aConnection);
+        void Handle(Worker& worker, Connection& aConnection, const char* line, std::size_t length);
+        //sends what it can of the replies; reading is paused while any are left unsent, so a
+        //client that doesn't read its replies can't make the server buffer without limit
+        bool Write(Worker& worker, Connection& aConnection);
+        void Close(Worker& worker, Connection& aConnection);
+
+        ServerConfig m_Config;
+        int m_ListenFd;
+        int m_StopFd;
+        std::vector<Worker> m_Workers;
+};
+
+inline TableServer::TableServer(const ServerConfig& config):
+    m_Config(config),
+    m_ListenFd(-1),
+    m_StopFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{}
+
+inline TableServer::~TableServer() {
+    if (m_ListenFd >= 0) {
+        close(m_ListenFd);
+        unlink(m_Config.path.c_str());
+    }
+    close(m_StopFd);
+}
+
+inline bool TableServer::Listen() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (m_Config.path.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    std::strcpy(address.sun_path, m_Config.path.c_str());
+    //a socket left behind by a server that didn't shut down cleanly would stop the bind
+    struct stat status;
+    if (stat(address.sun_path, &status) == 0 && S_ISSOCK(status.st_mode)) {
+        unlink(address.sun_path);
+    }
+    m_ListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_ListenFd < 0) {
+        return false;
+    }
+    if (bind(m_ListenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(m_ListenFd, SOMAXCONN) < 0) {
+        int error = errno;
+        close(m_ListenFd);
+        m_ListenFd = -1;
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+inline void TableServer::Run() {
+    m_Workers.assign(m_Config.numWorkers, Worker());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < m_Config.numWorkers; ++i) {
+        Worker& worker = m_Workers[i];
+        worker.index = i;
+        worker.epollFd = epoll_create1(EPOLL_CLOEXEC);
+        worker.numConnections = 0;
+        worker.numTables = 0;
+        worker.numRequests = 0;
+        //every worker waits on the listening socket; EPOLLEXCLUSIVE wakes just one of them for a
+        //new connection rather than all of them
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd = m_ListenFd;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, m_ListenFd, &event);
+        event.events = EPOLLIN;
+        event.data.fd = m_StopFd;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, m_StopFd, &event);
+        threads.push_back(std::thread(&TableServer::Serve, this, std::ref(worker)));
+    }
+    for (int i = 0; i < m_Config.numWorkers; ++i) {
+        threads[i].join();
+    }
+}
+
+inline void TableServer::Stop() {
+    //the event is never read, so it stays readable and wakes every worker
+    std::uint64_t one = 1;
+    ssize_t written = write(m_StopFd, &one, sizeof(one));
+    (void)written;
+}
+
+inline long long TableServer::GetConnections() const {
+    long long total = 0;
+    for (std::size_t i = 0; i < m_Workers.size(); ++i) {
+        total += m_Workers[i].numConnections;
+    }
+    return total;
+}
+
+inline long long TableServer::GetTables() const {
+    long long total = 0;
+    for (std::size_t i = 0; i < m_Workers.size(); ++i) {
+        total += m_Workers[i].numTables;
+    }
+    return total;
+}
+
+inline long long TableServer::GetRequests() const {
+    long long total = 0;
+    for (std::size_t i = 0; i < m_Workers.size(); ++i) {
+        total += m_Workers[i].numRequests;
+    }
+    return total;
+}
+
+inline void TableServer::Serve(Worker& worker) {
+    const int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+    bool isStopping = false;
+    while (!isStopping) {
+        int numEvents = epoll_wait(worker.epollFd, events, MAX_EVENTS, -1);
+        for (int i = 0; i < numEvents; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == m_StopFd) {
+                isStopping = true;
+            }
+            else if (fd == m_ListenFd) {
+                Accept(worker);
+            }
+            else if (fd < static_cast<int>(worker.connections.size()) && worker.connections[fd] != 0) {
+                Connection& aConnection = *worker.connections[fd];
+                bool isOpen = true;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    //the client is gone, any replies still owed can't be delivered
+                    Close(worker, aConnection);
+                    isOpen = false;
+                }
+                if (isOpen && (events[i].events & EPOLLOUT)) {
+                    isOpen = Write(worker, aConnection);
+                }
+                if (isOpen && (events[i].events & EPOLLIN)) {
+                    Read(worker, aConnection);
+                }
+            }
+        }
+    }
+    for (std::size_t fd = 0; fd < worker.connections.size(); ++fd) {
+        if (worker.connections[fd] != 0) {
+            Close(worker, *worker.connections[fd]);
+        }
+    }
+    close(worker.epollFd);
+}
+
+inline void TableServer::Accept(Worker& worker) {
+    while (true) {
+        int fd = accept4(m_ListenFd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            //EAGAIN once there are no more waiting, or another worker got there first
+            return;
+        }
+        if (fd >= static_cast<int>(worker.connections.size())) {
+            worker.connections.resize(fd + 1, 0);
+        }
+        Connection* pConnection = new Connection;
+        pConnection->fd = fd;
+        pConnection->numSent = 0;
+        pConnection->isWriting = false;
+        worker.connections[fd] = pConnection;
+        ++worker.numConnections;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+inline bool TableServer::Read(Worker& worker, Connection& aConnection) {
+    char buffer[16384];
+    ssize_t numRead = read(aConnection.fd, buffer, sizeof(buffer));
+    if (numRead == 0 || (numRead < 0 && errno != EAGAIN && errno != EINTR)) {
+        Close(worker, aConnection);
+        return false;
+    }
+    if (numRead < 0) {
+        return true;
+    }
+    aConnection.in.append(buffer, numRead);
+    //answer every complete line, then keep whatever partial line is left for the next read. a line
+    //longer than MAX_LINE ends the connection whether it arrived whole or is still coming
+    std::size_t start = 0;
+    std::size_t end = aConnection.in.find('\n');
+    bool isTooLong = false;
+    while (end != std::string::npos && !isTooLong) {
+        std::size_t length = end - start;
+        if (length > 0 && aConnection.in[end - 1] == '\r') {
+            --length;
+        }
+        isTooLong = (length > static_cast<std::size_t>(MAX_LINE));
+        if (!isTooLong) {
+            Handle(worker, aConnection, aConnection.in.data() + start, length);
+        }
+        start = end + 1;
+        end = aConnection.in.find('\n', start);
+    }
+    aConnection.in.erase(0, start);
+    if (isTooLong || aConnection.in.size() > static_cast<std::size_t>(MAX_LINE)) {
+        aConnection.out += "error line too long\n";
+        Write(worker, aConnection);
+        Close(worker, aConnection);
+        return false;
+    }
+    return Write(worker, aConnection);
+}
+
+inline void TableServer::Handle(Worker& worker, Connection& aConnection, const char* line, std::size_t length) {
+    ++worker.numRequests;
+    if (length == 1 && line[0] == 'N') {
+        if (aConnection.tables.size() >= static_cast<std::size_t>(MAX_TABLES_PER_CONNECTION)) {
+            aConnection.out += "error too many tables\n";
+            return;
+        }
+        int id = static_cast<int>(aConnection.tables.size());
+        //every table gets its own seed rather than its own stream of the server's seed: a stream
+        //costs a generator jump per table already open, while Rng::Seed mixes even neighbouring
+        //seeds into unrelated sequences for nothing
+        std::uint64_t serial = worker.numTables * m_Config.numWorkers + worker.index;
+        std::uint64_t seed = m_Config.seed ^ (serial * 0x9E3779B97F4A7C15ull);
+        aConnection.tables.push_back(new ServerTable(id, seed, m_Config.numDecks, m_Config.penetration));
+        ++worker.numTables;
+        appendNumber(aConnection.out, id);
+        aConnection.out += " open\n";
+        return;
+    }
+    char action = (length > 0) ? line[0] : '\0';
+    if ((action != 'D' && action != 'H' && action != 'S') || length < 3 || line[1] != ' ') {
+        aConnection.out += "error unknown request\n";
+        return;
+    }
+    std::size_t id = 0;
+    for (std::size_t i = 2; i < length; ++i) {
+        if (line[i] < '0' || line[i] > '9' || id >= aConnection.tables.size()) {
+            id = aConnection.tables.size();
+            break;
+        }
+        id = id * 10 + (line[i] - '0');
+    }
+    if (id >= aConnection.tables.size()) {
+        aConnection.out += "error unknown table\n";
+        return;
+    }
+    aConnection.tables[id]->Act(action, aConnection.out);
+}
+
+inline bool TableServer::Write(Worker& worker, Connection& aConnection) {
+    while (aConnection.numSent < aConnection.out.size()) {
+        //MSG_NOSIGNAL so a client that has gone away is an error here rather than a SIGPIPE
+        ssize_t numSent = send(aConnection.fd, aConnection.out.data() + aConnection.numSent,
+                               aConnection.out.size() - aConnection.numSent, MSG_NOSIGNAL);
+        if (numSent < 0) {
+            if (errno == EAGAIN) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            Close(worker, aConnection);
+            return false;
+        }
+        aConnection.numSent += numSent;
+    }
+    bool isWriting = (aConnection.numSent < aConnection.out.size());
+    if (!isWriting) {
+        aConnection.out.clear();
+        aConnection.numSent = 0;
+    }
+    if (isWriting != aConnection.isWriting) {
+        epoll_event event;
+        event.events = isWriting ? EPOLLOUT : EPOLLIN;
+        event.data.fd = aConnection.fd;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, aConnection.fd, &event);
+        aConnection.isWriting = isWriting;
+    }
+    return true;
+}
+
+inline void TableServer::Close(Worker& worker, Connection& aConnection) {
+    epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, aConnection.fd, 0);
+    close(aConnection.fd);
+    worker.connections[aConnection.fd] = 0;
+    std::vector<ServerTable*>::iterator pTable;
+    for (pTable = aConnection.tables.begin(); pTable != aConnection.tables.end(); ++pTable) {
+        delete *pTable;
+        *pTable = 0;
+    }
+    delete &aConnection;
+}
+
+#endif
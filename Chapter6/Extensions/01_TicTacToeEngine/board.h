@@ -0,0 +1,159 @@
+//Board
+//The Tic-Tac-Toe board as a pair of bitmasks, one per side, with wins looked up in a table
+
+#ifndef TICTACTOE_BOARD_H
+#define TICTACTOE_BOARD_H
+
+#include <cstddef>
+#include <vector>
+
+//the book's pieces and results
+const char X = 'X';
+const char O = 'O';
+const char EMPTY = ' ';
+const char TIE = 'T';
+const char NO_ONE = 'N';
+
+const int NUM_SQUARES = 9;
+//every square's bit set
+const unsigned int ALL_SQUARES = (1u << NUM_SQUARES) - 1;
+
+//the book's WINNING_ROWS as masks, each line's three squares as three bits
+const int TOTAL_ROWS = 8;
+const unsigned int WINNING_LINES[TOTAL_ROWS] = {0x007, 0x038, 0x1C0,
+                                                0x049, 0x092, 0x124,
+                                                0x111, 0x054};
+
+//for every one of the 512 ways a side can hold squares, whether they include a whole line.
+//it's filled in by the compiler (a constexpr constructor needs C++14, which g++ uses by default),
+//so it is in the program's data from the start and never built at run time
+struct WinTable {
+    bool isWin[ALL_SQUARES + 1];
+
+    constexpr WinTable();
+};
+
+constexpr WinTable::WinTable(): isWin() {
+    for (unsigned int mask = 0; mask <= ALL_SQUARES; ++mask) {
+        for (int row = 0; row < TOTAL_ROWS; ++row) {
+            if ((mask & WINNING_LINES[row]) == WINNING_LINES[row]) {
+                isWin[mask] = true;
+            }
+        }
+    }
+}
+
+constexpr WinTable WIN_TABLE;
+
+//square i is bit i of a side's mask, so a board is four bytes and copying it is free. the book's
+//vector<char> needs a heap allocation, and its winner checks 24 squares and then counts 9
+class Board {
+    public:
+        //an empty board
+        Board();
+        //the same position as one of the book's boards
+        explicit Board(const std::vector<char>& squares);
+        //X, O or EMPTY, as the book's board would hold
+        char GetSquare(int square) const;
+        bool isLegal(int move) const;
+        //puts the piece on an empty square
+        void Place(int move, char piece);
+        //empties a square, undoing a Place
+        void Remove(int move);
+        //the squares held by a piece, and the squares held by nobody
+        unsigned int GetMask(char piece) const;
+        unsigned int GetEmpty() const;
+        //X or O if that side has a line, TIE if the board is full, otherwise NO_ONE; the same
+        //as the book's winner, with one table lookup per side
+        char Winner() const;
+        //the same answer by ANDing the side's mask with each line, without the table
+        char WinnerByLines() const;
+        bool operator==(const Board& other) const;
+        bool operator!=(const Board& other) const;
+    private:
+        //X's squares then O's
+        unsigned short m_Masks[2];
+
+        static int Side(char piece);
+};
+
+inline Board::Board() {
+    m_Masks[0] = 0;
+    m_Masks[1] = 0;
+}
+
+inline Board::Board(const std::vector<char>& squares) {
+    m_Masks[0] = 0;
+    m_Masks[1] = 0;
+    for (std::size_t square = 0; square < squares.size() && square < NUM_SQUARES; ++square) {
+        if (squares[square] != EMPTY) {
+            Place(static_cast<int>(square), squares[square]);
+        }
+    }
+}
+
+inline int Board::Side(char piece) {
+    return (piece == X) ? 0 : 1;
+}
+
+inline char Board::GetSquare(int square) const {
+    unsigned int bit = 1u << square;
+    if (m_Masks[0] & bit) {
+        return X;
+    }
+    return (m_Masks[1] & bit) ? O : EMPTY;
+}
+
+inline bool Board::isLegal(int move) const {
+    return ((GetEmpty() >> move) & 1) != 0;
+}
+
+inline void Board::Place(int move, char piece) {
+    m_Masks[Side(piece)] |= static_cast<unsigned short>(1u << move);
+}
+
+inline void Board::Remove(int move) {
+    unsigned short keep = static_cast<unsigned short>(~(1u << move));
+    m_Masks[0] &= keep;
+    m_Masks[1] &= keep;
+}
+
+inline unsigned int Board::GetMask(char piece) const {
+    return m_Masks[Side(piece)];
+}
+
+inline unsigned int Board::GetEmpty() const {
+    return ALL_SQUARES & ~(m_Masks[0] | m_Masks[1]);
+}
+
+inline char Board::Winner() const {
+    if (WIN_TABLE.isWin[m_Masks[0]]) {
+        return X;
+    }
+    if (WIN_TABLE.isWin[m_Masks[1]]) {
+        return O;
+    }
+    //a full board is a mask compare, rather than counting empty squares
+    return ((m_Masks[0] | m_Masks[1]) == ALL_SQUARES) ? TIE : NO_ONE;
+}
+
+inline char Board::WinnerByLines() const {
+    for (int side = 0; side < 2; ++side) {
+        for (int row = 0; row < TOTAL_ROWS; ++row) {
+            if ((m_Masks[side] & WINNING_LINES[row]) == WINNING_LINES[row]) {
+                return (side == 0) ? X : O;
+            }
+        }
+    }
+    return ((m_Masks[0] | m_Masks[1]) == ALL_SQUARES) ? TIE : NO_ONE;
+}
+
+inline bool Board::operator==(const Board& other) const {
+    return m_Masks[0] == other.m_Masks[0] && m_Masks[1] == other.m_Masks[1];
+}
+
+inline bool Board::operator!=(const Board& other) const {
+    return !(*this == other);
+}
+
+#endif
@@ -0,0 +1,131 @@
+//Endgame
+//The best move and score of every Tic-Tac-Toe position, solved by the compiler and built into the program
+
+#ifndef TICTACTOE_ENDGAME_H
+#define TICTACTOE_ENDGAME_H
+
+#include "board.h"
+#include "search.h"
+
+//3^9 positions: each square is empty, X or O, so a position is a nine digit base 3 number with
+//square i as digit i, 0 for empty, 1 for X and 2 for O
+const int NUM_POSITIONS = 19683;
+
+//every position's best move and score for the side to move, X when both sides have made the same
+//number of moves and O otherwise, as in the book's game. the constructor is a whole minimax
+//search, but it's constexpr, so the compiler runs it and the program starts with the finished
+//table in its data; looking a move up at run time is one load.
+//
+//placing a piece adds 3^square or 2 * 3^square to a position's number, so every position a move
+//leads to has a higher number. working down from the highest number, a position's moves have
+//always been solved by the time we get to it, and every position is solved exactly once
+class EndgameTable {
+    public:
+        //the move of a position with none, because the game is over or can't happen
+        static const int NO_MOVE = 15;
+
+        constexpr EndgameTable();
+        //the position's number
+        int GetIndex(const Board& board) const;
+        //the best move for the side to move, the first in MOVE_ORDER among equally good ones
+        int GetMove(const Board& board) const;
+        //the score with best play, scored the same way as Engine
+        int GetScore(const Board& board) const;
+        //the same, by position number
+        constexpr int GetMove(int index) const;
+        constexpr int GetScore(int index) const;
+    private:
+        //the move in the low four bits, the score plus 8 in the high four
+        unsigned char m_Entries[NUM_POSITIONS];
+        //the position number of each mask's squares all holding 1s, so a board's number is
+        //one lookup per side
+        unsigned short m_Ternary[ALL_SQUARES + 1];
+};
+
+constexpr EndgameTable::EndgameTable(): m_Entries(), m_Ternary() {
+    int powers[NUM_SQUARES] = {};
+    int power = 1;
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        powers[square] = power;
+        power *= 3;
+    }
+    for (unsigned int mask = 0; mask <= ALL_SQUARES; ++mask) {
+        int index = 0;
+        for (int square = 0; square < NUM_SQUARES; ++square) {
+            index += ((mask >> square) & 1) ? powers[square] : 0;
+        }
+        m_Ternary[mask] = static_cast<unsigned short>(index);
+    }
+
+    for (int index = NUM_POSITIONS - 1; index >= 0; --index) {
+        unsigned int xMask = 0;
+        unsigned int oMask = 0;
+        int numX = 0;
+        int numO = 0;
+        int digits = index;
+        for (int square = 0; square < NUM_SQUARES; ++square) {
+            int digit = digits % 3;
+            digits /= 3;
+            xMask |= (digit == 1) ? (1u << square) : 0;
+            oMask |= (digit == 2) ? (1u << square) : 0;
+            numX += (digit == 1) ? 1 : 0;
+            numO += (digit == 2) ? 1 : 0;
+        }
+        int move = NO_MOVE;
+        int best = 0;
+        bool isXTurn = (numX == numO);
+        unsigned int mine = isXTurn ? xMask : oMask;
+        unsigned int theirs = isXTurn ? oMask : xMask;
+        unsigned int empty = ALL_SQUARES & ~(xMask | oMask);
+        int numEmpty = NUM_SQUARES - numX - numO;
+        if (numX != numO && numX != numO + 1) {
+            //not a position a game can reach, left as a draw with no move
+        }
+        else if (WIN_TABLE.isWin[theirs]) {
+            best = -(1 + numEmpty);
+        }
+        else if (empty != 0 && !WIN_TABLE.isWin[mine]) {
+            best = -NUM_SQUARES - 1;
+            for (int i = 0; i < NUM_SQUARES; ++i) {
+                int square = MOVE_ORDER[i];
+                if ((empty >> square) & 1) {
+                    int child = index + (isXTurn ? 1 : 2) * powers[square];
+                    int score = -((m_Entries[child] >> 4) - 8);
+                    if (score > best) {
+                        best = score;
+                        move = square;
+                    }
+                }
+            }
+        }
+        m_Entries[index] = static_cast<unsigned char>(((best + 8) << 4) | move);
+    }
+}
+
+constexpr int EndgameTable::GetMove(int index) const {
+    return m_Entries[index] & 0x0F;
+}
+
+constexpr int EndgameTable::GetScore(int index) const {
+    return (m_Entries[index] >> 4) - 8;
+}
+
+inline int EndgameTable::GetIndex(const Board& board) const {
+    return m_Ternary[board.GetMask(X)] + 2 * m_Ternary[board.GetMask(O)];
+}
+
+inline int EndgameTable::GetMove(const Board& board) const {
+    return GetMove(GetIndex(board));
+}
+
+inline int EndgameTable::GetScore(const Board& board) const {
+    return GetScore(GetIndex(board));
+}
+
+constexpr EndgameTable ENDGAME_TABLE;
+
+//the whole game is a draw with best play, and the first move is the centre
+static_assert(ENDGAME_TABLE.GetScore(0) == 0 && ENDGAME_TABLE.GetMove(0) == 4,
+              "the empty board should be a draw, opening in the centre");
+
+#endif
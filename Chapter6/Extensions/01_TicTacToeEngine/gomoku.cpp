@@ -0,0 +1,171 @@
+// Gomoku
+// The book's game of tic-tac-toe on any m,n,k board, 15 by 15 with five in a row by default, against
+// a computer playing by Monte Carlo tree search
+// usage: gomoku [rows columns lineLength [playouts]]
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#include "mcts.h"
+#include "mnkBoard.h"
+
+using namespace std;
+
+//function prototypes
+void instructions(const MnkBoard& board);
+char askYesNo(const char* question);
+int askNumber(const char* question, int high, int low = 0);
+char humanPiece();
+char opponent(char piece);
+void displayBoard(const MnkBoard& board);
+int humanMove(const MnkBoard& board);
+int computerMove(const MnkBoard& board, char computer, Mcts& mcts, long long playouts);
+void announceWinner(char winner, char computer, char human);
+
+// main function
+int main(int argc, char* argv[]) {
+    int rows = (argc > 3) ? atoi(argv[1]) : 15;
+    int columns = (argc > 3) ? atoi(argv[2]) : 15;
+    int lineLength = (argc > 3) ? atoi(argv[3]) : 5;
+    long long playouts = (argc > 4) ? atoll(argv[4]) : 100000;
+    if (argc == 2 || argc == 3 || rows < 1 || rows > MnkBoard::MAX_SIDE || columns < 1 ||
+        columns > MnkBoard::MAX_SIDE || lineLength < 1 || playouts < 1) {
+        cerr << "usage: gomoku [rows columns lineLength [playouts]], with at most " << MnkBoard::MAX_SIDE;
+        cerr << " rows and columns\n";
+        return 1;
+    }
+    int move;
+    MnkBoard board(rows, columns, lineLength);
+    Mcts mcts(static_cast<unsigned long long>(time(0)));
+
+    instructions(board);
+    char human = humanPiece();
+    char computer = opponent(human);
+    char turn = X;
+    displayBoard(board);
+
+    while (board.Winner() == NO_ONE) {
+        if (turn == human) {
+            move = humanMove(board);
+            board.Place(move, human);
+        }
+        else {
+            move = computerMove(board, computer, mcts, playouts);
+            board.Place(move, computer);
+        }
+        displayBoard(board);
+        turn = opponent(turn);
+    }
+    announceWinner(board.Winner(), computer, human);
+    return 0;
+}
+
+void instructions(const MnkBoard& board) {
+    cout << "Welcome to the ultimate man-machine showdown: " << board.GetLineLength() << " in a row on a ";
+    cout << board.GetRows() << " by " << board.GetColumns() << " board\n";
+    cout << "--where human brain is pit against silicon processor\n\n";
+
+    cout << "Make your move known by entering a row and then a column, as\n";
+    cout << "numbered around the board.\n\n";
+
+    cout << "Prepare yourself, human. The battle is about to begin.\n\n";
+}
+
+char askYesNo(const char* question) {
+    char response;
+    do {
+        cout << question << "(y/n): ";
+        cin >> response;
+    } while (response != 'y' && response != 'n');
+
+    return response;
+}
+
+int askNumber(const char* question, int high, int low) {
+    int number;
+    do {
+        cout << question << " (" << low << " - " << high << " ): ";
+        cin >> number;
+    } while (number > high || number < low);
+
+    return number;
+}
+
+char humanPiece() {
+    char go_first = askYesNo("Do you require the first move?");
+    if (go_first == 'y') {
+        cout << "\nThen take the first move. You will need it.\n";
+        return X;
+    }
+    else {
+        cout << "\nYour bravery will be your undoing... I will go first.\n";
+        return O;
+    }
+}
+
+char opponent(char piece) {
+    if (piece == X) {
+        return O;
+    }
+    else {
+        return X;
+    }
+}
+
+//the rows numbered down the side and the columns across the top, each square as its piece or a .
+void displayBoard(const MnkBoard& board) {
+    cout << "\n\t  ";
+    for (int column = 0; column < board.GetColumns(); ++column) {
+        cout << (column < 10 ? "  " : " ") << column;
+    }
+    for (int row = 0; row < board.GetRows(); ++row) {
+        cout << "\n\t" << (row < 10 ? " " : "") << row;
+        for (int column = 0; column < board.GetColumns(); ++column) {
+            char square = board.GetSquare(row * board.GetColumns() + column);
+            cout << "  " << (square == EMPTY ? '.' : square);
+        }
+    }
+    cout << "\n\n";
+}
+
+int humanMove(const MnkBoard& board) {
+    int move;
+    do {
+        int row = askNumber("Which row will you move in?", board.GetRows() - 1);
+        int column = askNumber("Which column will you move in?", board.GetColumns() - 1);
+        move = row * board.GetColumns() + column;
+        if (!board.isLegal(move)) {
+            cout << "\nThat square is already occupied, foolish human.\n";
+        }
+    } while (!board.isLegal(move));
+    cout << "Fine...\n";
+    return move;
+}
+
+int computerMove(const MnkBoard& board, char computer, Mcts& mcts, long long playouts) {
+    MctsResult result = mcts.Search(board, computer, playouts);
+    cout << "I shall take row " << result.move / board.GetColumns() << ", column ";
+    cout << result.move % board.GetColumns() << " (I win " << static_cast<int>(100 * result.winRate + 0.5);
+    cout << "% of my " << result.playouts << " games from here)" << endl;
+    return result.move;
+}
+
+void announceWinner(char winner, char computer, char human) {
+    if (winner == computer) {
+        cout << winner << "'s won!\n";
+        cout << "As I predicted, human, I am triumphant once more -- proof\n";
+        cout << "that computers are superior to humans in all regards.\n";
+    }
+    else if (winner == human) {
+        cout << winner << "'s won!\n";
+        cout << "No, no! It cannot be! Somehow you tricked me, human.\n";
+        cout << "But never again! I the computer, so swear it!\n";
+    }
+
+    else {
+        cout << "It's a tie.\n";
+        cout << "You were most lucky, human, and somehow managed to tie me.\n";
+        cout << "Celebrate... for tis the best you will ever achieve.\n";
+    }
+}
@@ -0,0 +1,147 @@
+//LineBoard
+//A Tic-Tac-Toe board that counts each side's pieces in every line as moves are made and unmade, so
+//a win is found by looking only at the lines through the last move, and a tie by one compare
+
+#ifndef TICTACTOE_LINEBOARD_H
+#define TICTACTOE_LINEBOARD_H
+
+#include "board.h"
+
+//each side's piece count on every line is kept in four bits of one word, line i in bits 4i to
+//4i + 3. a square adds one to the count of each line through it, at most four of them, so for
+//each square the compiler works out the word that adds them all at once
+struct LineSteps {
+    unsigned int steps[NUM_SQUARES];
+
+    constexpr LineSteps();
+};
+
+constexpr LineSteps::LineSteps(): steps() {
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        for (int row = 0; row < TOTAL_ROWS; ++row) {
+            if ((WINNING_LINES[row] >> square) & 1) {
+                steps[square] |= 1u << (4 * row);
+            }
+        }
+    }
+}
+
+constexpr LineSteps LINE_STEPS;
+
+//the book's winner looks at all eight lines, and then counts the empty squares, after every move,
+//even for each square its computerMove tries. a LineBoard keeps, for each side, how many of its
+//pieces are on each line, and how many squares are empty. placing a piece adds one to the lines
+//through its square, in a single add, and a line reaching three is a win; no other line can have
+//changed. a count is at most three, so adding five to every count at once sets a count's top bit
+//only if it was three, with no carry into the next line. a full board is the empty count reaching
+//zero. Remove takes the piece back off, so a search can try a move and undo it on the one board,
+//rather than copying the board for every move it tries
+class LineBoard {
+    public:
+        //an empty board
+        LineBoard();
+        //the same position as a bitmask board
+        explicit LineBoard(const Board& board);
+        //X, O or EMPTY
+        char GetSquare(int square) const;
+        bool isLegal(int move) const;
+        //puts the piece on an empty square, counting it on the lines through the square
+        void Place(int move, char piece);
+        //empties the square the latest Place filled, undoing it and any win it made
+        void Remove(int move);
+        int GetNumEmpty() const;
+        //X or O if that side has a line, TIE if the board is full, otherwise NO_ONE; a load and a
+        //compare, whatever is on the board
+        char Winner() const;
+    private:
+        static int Side(char piece);
+
+        char m_Squares[NUM_SQUARES];
+        //X's pieces in each line, then O's, four bits a line
+        unsigned int m_Counts[2];
+        char m_Winner;
+        int m_NumEmpty;
+};
+
+inline LineBoard::LineBoard(): m_Counts(), m_Winner(NO_ONE), m_NumEmpty(NUM_SQUARES) {
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        m_Squares[square] = EMPTY;
+    }
+}
+
+inline LineBoard::LineBoard(const Board& board): LineBoard() {
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        if (board.GetSquare(square) != EMPTY) {
+            Place(square, board.GetSquare(square));
+        }
+    }
+}
+
+inline int LineBoard::Side(char piece) {
+    return (piece == X) ? 0 : 1;
+}
+
+inline char LineBoard::GetSquare(int square) const {
+    return m_Squares[square];
+}
+
+inline bool LineBoard::isLegal(int move) const {
+    return m_Squares[move] == EMPTY;
+}
+
+inline void LineBoard::Place(int move, char piece) {
+    m_Squares[move] = piece;
+    --m_NumEmpty;
+    unsigned int& counts = m_Counts[Side(piece)];
+    counts += LINE_STEPS.steps[move];
+    if ((counts + 0x55555555u) & 0x88888888u) {
+        m_Winner = piece;
+    }
+}
+
+inline void LineBoard::Remove(int move) {
+    m_Counts[Side(m_Squares[move])] -= LINE_STEPS.steps[move];
+    m_Squares[move] = EMPTY;
+    ++m_NumEmpty;
+    m_Winner = NO_ONE;
+}
+
+inline int LineBoard::GetNumEmpty() const {
+    return m_NumEmpty;
+}
+
+inline char LineBoard::Winner() const {
+    if (m_Winner != NO_ONE) {
+        return m_Winner;
+    }
+    return (m_NumEmpty == 0) ? TIE : NO_ONE;
+}
+
+//the book's computerMove: win if it can, block if it must, otherwise the best open square. each
+//square is tried by placing a piece and taking it back off the one board, rather than on a copy
+inline int heuristicMove(LineBoard& board, char computer) {
+    const int BEST_MOVES[NUM_SQUARES] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+    char human = (computer == X) ? O : X;
+    //the computer's winning move, then the human's
+    char pieces[2] = {computer, human};
+    for (int p = 0; p < 2; ++p) {
+        for (int move = 0; move < NUM_SQUARES; ++move) {
+            if (board.isLegal(move)) {
+                board.Place(move, pieces[p]);
+                bool isWin = (board.Winner() == pieces[p]);
+                board.Remove(move);
+                if (isWin) {
+                    return move;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < NUM_SQUARES; ++i) {
+        if (board.isLegal(BEST_MOVES[i])) {
+            return BEST_MOVES[i];
+        }
+    }
+    return -1;
+}
+
+#endif
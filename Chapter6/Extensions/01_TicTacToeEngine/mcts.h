@@ -0,0 +1,215 @@
+//Mcts
+//A player for any m,n,k-game, choosing moves by Monte Carlo tree search
+
+#ifndef TICTACTOE_MCTS_H
+#define TICTACTOE_MCTS_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../../../Common/rng.h"
+#include "mnkBoard.h"
+
+//what a search found: the move to make, how often it won, and how much work it took
+struct MctsResult {
+    //the square to take, or -1 if the game is already over
+    int move;
+    //the share of the move's playouts won by the side choosing it, a draw counting half
+    double winRate;
+    long long playouts;
+    int nodes;
+};
+
+//a board much bigger than Tic-Tac-Toe's has far too many games to search to their ends, so
+//instead each playout walks down a tree of the moves tried so far, picking the move with the best
+//upper confidence bound (UCT, a balance of how well a move has done and how little it's been
+//tried), adds the position it reaches to the tree, and finishes the game with random moves. the
+//result is counted for every move on the way down. with enough playouts the tree grows towards
+//the best moves, and the move played is the one tried most.
+//
+//the tree's nodes come from a fixed pool, allocated once, and a node's children are next to each
+//other in it, so a search never allocates. children are only made for the empty squares within
+//NEIGHBOURHOOD of a piece, since a move far from every other piece is almost never best
+class Mcts {
+    public:
+        explicit Mcts(std::uint64_t seed = 1, int maxNodes = 1 << 20);
+        //restarts the random moves; equal seeds give equal searches
+        void Seed(std::uint64_t seed);
+        //the best move for piece, after the given number of playouts
+        MctsResult Search(const MnkBoard& board, char piece, long long playouts);
+        //just the move
+        int BestMove(const MnkBoard& board, char piece, long long playouts);
+        //plays random moves from the board, turn first, until the game ends, and returns the winner
+        char Playout(MnkBoard& board, char turn);
+    private:
+        static const int NEIGHBOURHOOD = 2;
+        //how strongly the search favours moves it has tried least
+        static constexpr double EXPLORATION = 1.0;
+
+        struct Node {
+            int parent;
+            int firstChild;
+            int visits;
+            //2 for every playout won by the side that made the move, 1 for every draw
+            int points;
+            short move;
+            short numChildren;
+        };
+
+        //the child with the best upper confidence bound, or the first never tried
+        int Select(int node) const;
+        //gives the node a child for every move worth trying, if the pool has room
+        void Expand(int node, const MnkBoard& board);
+        int AddNode(int parent, int move);
+
+        std::vector<Node> m_Nodes;
+        int m_NumNodes;
+        //a mark per square for Expand, and the mark it's up to, so it never has to clear them
+        unsigned int m_Marks[MnkBoard::MAX_SQUARES];
+        unsigned int m_Mark;
+        Rng m_Rng;
+};
+
+inline Mcts::Mcts(std::uint64_t seed, int maxNodes): m_Nodes(maxNodes), m_NumNodes(0), m_Marks(), m_Mark(0),
+    m_Rng(seed) {}
+
+inline void Mcts::Seed(std::uint64_t seed) {
+    m_Rng.Seed(seed);
+}
+
+inline int Mcts::AddNode(int parent, int move) {
+    Node& node = m_Nodes[m_NumNodes];
+    node.parent = parent;
+    node.firstChild = -1;
+    node.visits = 0;
+    node.points = 0;
+    node.move = static_cast<short>(move);
+    node.numChildren = 0;
+    return m_NumNodes++;
+}
+
+inline void Mcts::Expand(int node, const MnkBoard& board) {
+    if (m_NumNodes + board.GetNumEmpty() > static_cast<int>(m_Nodes.size())) {
+        return;
+    }
+    int first = m_NumNodes;
+    int columns = board.GetColumns();
+    int rows = board.GetRows();
+    ++m_Mark;
+    for (int i = 0; i < board.GetNumPlaced(); ++i) {
+        int placed = board.GetPlaced(i);
+        int row = placed / columns;
+        int column = placed % columns;
+        for (int r = row - NEIGHBOURHOOD; r <= row + NEIGHBOURHOOD; ++r) {
+            for (int c = column - NEIGHBOURHOOD; c <= column + NEIGHBOURHOOD; ++c) {
+                if (r < 0 || r >= rows || c < 0 || c >= columns) {
+                    continue;
+                }
+                int square = r * columns + c;
+                if (m_Marks[square] != m_Mark && board.GetSquare(square) == EMPTY) {
+                    m_Marks[square] = m_Mark;
+                    AddNode(node, square);
+                }
+            }
+        }
+    }
+    //an empty board, or one whose pieces have no empty squares near them
+    if (m_NumNodes == first) {
+        for (int i = 0; i < board.GetNumEmpty(); ++i) {
+            AddNode(node, board.GetEmpty(i));
+        }
+    }
+    m_Nodes[node].firstChild = first;
+    m_Nodes[node].numChildren = static_cast<short>(m_NumNodes - first);
+}
+
+inline int Mcts::Select(int node) const {
+    const Node& parent = m_Nodes[node];
+    double logVisits = std::log(static_cast<double>(parent.visits));
+    int best = parent.firstChild;
+    double bestBound = -1.0;
+    for (int child = parent.firstChild; child < parent.firstChild + parent.numChildren; ++child) {
+        const Node& tried = m_Nodes[child];
+        if (tried.visits == 0) {
+            return child;
+        }
+        double bound = tried.points / (2.0 * tried.visits) + EXPLORATION * std::sqrt(logVisits / tried.visits);
+        if (bound > bestBound) {
+            bestBound = bound;
+            best = child;
+        }
+    }
+    return best;
+}
+
+inline char Mcts::Playout(MnkBoard& board, char turn) {
+    while (board.Winner() == NO_ONE) {
+        board.Place(board.GetEmpty(static_cast<int>(m_Rng.Below(board.GetNumEmpty()))), turn);
+        turn = (turn == X) ? O : X;
+    }
+    return board.Winner();
+}
+
+inline MctsResult Mcts::Search(const MnkBoard& board, char piece, long long playouts) {
+    MctsResult result;
+    result.move = -1;
+    result.winRate = 0.0;
+    result.playouts = 0;
+    m_NumNodes = 0;
+    AddNode(-1, -1);
+    if (board.Winner() != NO_ONE) {
+        result.nodes = m_NumNodes;
+        return result;
+    }
+    Expand(0, board);
+
+    for (; result.playouts < playouts; ++result.playouts) {
+        MnkBoard game = board;
+        char turn = piece;
+        int node = 0;
+        //down the tree to a position it doesn't go past yet
+        while (m_Nodes[node].numChildren > 0 && game.Winner() == NO_ONE) {
+            node = Select(node);
+            game.Place(m_Nodes[node].move, turn);
+            turn = (turn == X) ? O : X;
+        }
+        //a position tried once before gets its children, and the playout starts from the first
+        if (game.Winner() == NO_ONE && m_Nodes[node].visits > 0) {
+            Expand(node, game);
+            if (m_Nodes[node].numChildren > 0) {
+                node = m_Nodes[node].firstChild;
+                game.Place(m_Nodes[node].move, turn);
+                turn = (turn == X) ? O : X;
+            }
+        }
+        char winner = (game.Winner() == NO_ONE) ? Playout(game, turn) : game.Winner();
+
+        //each move on the way down scores for the side that made it
+        char mover = (turn == X) ? O : X;
+        for (; node >= 0; node = m_Nodes[node].parent) {
+            Node& visited = m_Nodes[node];
+            ++visited.visits;
+            visited.points += (winner == mover) ? 2 : ((winner == TIE) ? 1 : 0);
+            mover = (mover == X) ? O : X;
+        }
+    }
+
+    const Node& root = m_Nodes[0];
+    int best = root.firstChild;
+    for (int child = root.firstChild; child < root.firstChild + root.numChildren; ++child) {
+        if (m_Nodes[child].visits > m_Nodes[best].visits) {
+            best = child;
+        }
+    }
+    result.move = m_Nodes[best].move;
+    result.winRate = (m_Nodes[best].visits > 0) ? m_Nodes[best].points / (2.0 * m_Nodes[best].visits) : 0.0;
+    result.nodes = m_NumNodes;
+    return result;
+}
+
+inline int Mcts::BestMove(const MnkBoard& board, char piece, long long playouts) {
+    return Search(board, piece, playouts).move;
+}
+
+#endif
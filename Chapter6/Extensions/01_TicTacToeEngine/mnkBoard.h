@@ -0,0 +1,185 @@
+//MnkBoard
+//The board of an m,n,k-game: m rows, n columns, and k in a row wins. Tic-Tac-Toe is 3,3,3 and
+//Gomoku is 15,15,5
+
+#ifndef TICTACTOE_MNKBOARD_H
+#define TICTACTOE_MNKBOARD_H
+
+#include "board.h"
+
+//any size up to a Go board, kept in fixed arrays so a board never allocates and copying one is a
+//single block copy. squares are numbered along the rows, row * columns + column, the same way the
+//book numbers its nine. inside, every row has one extra cell and there's an extra row above and
+//below, all holding a border, so walking along a line stops at the edge without checking rows and
+//columns. one more border cell comes first, so even the first square's up-left neighbour is on the
+//board's array.
+//
+//a move can only complete a line through its own square, so Place walks just the four lines
+//through it, rather than checking every line on the board. the empty squares are kept in a list,
+//along with where each square is in it, so filling or emptying a square, picking a random empty
+//one and spotting a full board are all constant time
+class MnkBoard {
+    public:
+        static const int MAX_SIDE = 19;
+        static const int MAX_SQUARES = MAX_SIDE * MAX_SIDE;
+
+        //an empty board; rows and columns must be from 1 to MAX_SIDE, and lineLength at least 1
+        MnkBoard(int rows = 3, int columns = 3, int lineLength = 3);
+        int GetRows() const;
+        int GetColumns() const;
+        int GetLineLength() const;
+        int GetNumSquares() const;
+        //X, O or EMPTY
+        char GetSquare(int square) const;
+        bool isLegal(int move) const;
+        //puts the piece on an empty square, and checks the lines through it for a win
+        void Place(int move, char piece);
+        //empties the square the latest Place filled, undoing any win it made
+        void Remove(int move);
+        //the empty squares, 0 to GetNumEmpty() - 1, in no particular order
+        int GetNumEmpty() const;
+        int GetEmpty(int i) const;
+        //the filled squares, 0 to GetNumPlaced() - 1, in no particular order
+        int GetNumPlaced() const;
+        int GetPlaced(int i) const;
+        //X or O if that side has k in a row, TIE if the board is full, otherwise NO_ONE
+        char Winner() const;
+    private:
+        static const char BORDER = '#';
+        static const int MAX_CELLS = (MAX_SIDE + 2) * (MAX_SIDE + 1) + 1;
+        static const int NUM_DIRECTIONS = 4;
+
+        //how many of piece's squares are in a row, walking from cell by step
+        int Run(int cell, int step, char piece) const;
+
+        short m_Rows;
+        short m_Columns;
+        short m_LineLength;
+        short m_NumEmpty;
+        //the cell steps to the next square right, down, down and right, and down and left
+        short m_Steps[NUM_DIRECTIONS];
+        //the empty squares, then the filled ones
+        short m_Squares[MAX_SQUARES];
+        //where each square is in m_Squares
+        short m_Where[MAX_SQUARES];
+        //each square's cell
+        short m_Cells[MAX_SQUARES];
+        char m_Board[MAX_CELLS];
+        char m_Winner;
+};
+
+inline MnkBoard::MnkBoard(int rows, int columns, int lineLength):
+    m_Rows(static_cast<short>(rows)),
+    m_Columns(static_cast<short>(columns)),
+    m_LineLength(static_cast<short>(lineLength)),
+    m_NumEmpty(static_cast<short>(rows * columns)),
+    m_Winner(NO_ONE) {
+    int stride = columns + 1;
+    m_Steps[0] = 1;
+    m_Steps[1] = static_cast<short>(stride);
+    m_Steps[2] = static_cast<short>(stride + 1);
+    m_Steps[3] = static_cast<short>(stride - 1);
+    for (int cell = 0; cell < MAX_CELLS; ++cell) {
+        m_Board[cell] = BORDER;
+    }
+    for (int square = 0; square < m_NumEmpty; ++square) {
+        int cell = (square / columns + 1) * stride + square % columns + 1;
+        m_Cells[square] = static_cast<short>(cell);
+        m_Board[cell] = EMPTY;
+        m_Squares[square] = static_cast<short>(square);
+        m_Where[square] = static_cast<short>(square);
+    }
+}
+
+inline int MnkBoard::GetRows() const {
+    return m_Rows;
+}
+
+inline int MnkBoard::GetColumns() const {
+    return m_Columns;
+}
+
+inline int MnkBoard::GetLineLength() const {
+    return m_LineLength;
+}
+
+inline int MnkBoard::GetNumSquares() const {
+    return m_Rows * m_Columns;
+}
+
+inline char MnkBoard::GetSquare(int square) const {
+    return m_Board[m_Cells[square]];
+}
+
+inline bool MnkBoard::isLegal(int move) const {
+    return move >= 0 && move < GetNumSquares() && GetSquare(move) == EMPTY;
+}
+
+inline int MnkBoard::Run(int cell, int step, char piece) const {
+    int length = 0;
+    for (cell += step; m_Board[cell] == piece; cell += step) {
+        ++length;
+    }
+    return length;
+}
+
+inline void MnkBoard::Place(int move, char piece) {
+    int cell = m_Cells[move];
+    m_Board[cell] = piece;
+
+    //swap the square with the last empty one, so the empty squares stay at the front
+    int last = m_NumEmpty - 1;
+    int other = m_Squares[last];
+    int where = m_Where[move];
+    m_Squares[where] = static_cast<short>(other);
+    m_Where[other] = static_cast<short>(where);
+    m_Squares[last] = static_cast<short>(move);
+    m_Where[move] = static_cast<short>(last);
+    m_NumEmpty = static_cast<short>(last);
+
+    for (int d = 0; d < NUM_DIRECTIONS; ++d) {
+        int step = m_Steps[d];
+        if (1 + Run(cell, step, piece) + Run(cell, -step, piece) >= m_LineLength) {
+            m_Winner = piece;
+            return;
+        }
+    }
+}
+
+inline void MnkBoard::Remove(int move) {
+    m_Board[m_Cells[move]] = EMPTY;
+    int first = m_NumEmpty;
+    int other = m_Squares[first];
+    int where = m_Where[move];
+    m_Squares[where] = static_cast<short>(other);
+    m_Where[other] = static_cast<short>(where);
+    m_Squares[first] = static_cast<short>(move);
+    m_Where[move] = static_cast<short>(first);
+    m_NumEmpty = static_cast<short>(first + 1);
+    m_Winner = NO_ONE;
+}
+
+inline int MnkBoard::GetNumEmpty() const {
+    return m_NumEmpty;
+}
+
+inline int MnkBoard::GetEmpty(int i) const {
+    return m_Squares[i];
+}
+
+inline int MnkBoard::GetNumPlaced() const {
+    return GetNumSquares() - m_NumEmpty;
+}
+
+inline int MnkBoard::GetPlaced(int i) const {
+    return m_Squares[m_NumEmpty + i];
+}
+
+inline char MnkBoard::Winner() const {
+    if (m_Winner != NO_ONE) {
+        return m_Winner;
+    }
+    return (m_NumEmpty == 0) ? TIE : NO_ONE;
+}
+
+#endif
@@ -0,0 +1,282 @@
+//Retrograde
+//Solves every position of 4 by 4 Tic-Tac-Toe, four in a row to win, working backwards from the
+//full board across threads, and reads the solved table back from a memory-mapped file
+
+#ifndef TICTACTOE_RETROGRADE_H
+#define TICTACTOE_RETROGRADE_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mnkBoard.h"
+
+const int SIDE_4X4 = 4;
+const int SQUARES_4X4 = SIDE_4X4 * SIDE_4X4;
+const unsigned int ALL_SQUARES_4X4 = (1u << SQUARES_4X4) - 1;
+//each square empty, X or O: a position is a 16 digit base 3 number, square i as digit i, 0 for
+//empty, 1 for X and 2 for O, as in the 3 by 3 EndgameTable
+const int POSITIONS_4X4 = 43046721;
+
+//how a position ends with best play, for the side to move; NOT_A_POSITION is a number no game
+//can reach, see Solver4x4::isPosition
+enum Outcome {LOSS, DRAW, WIN, NOT_A_POSITION};
+
+//the table file: these eight bytes, the number of positions as eight little endian bytes, then
+//four positions a byte, position i in bits 2 * (i % 4) and up of byte i / 4
+const char TABLE_MAGIC_4X4[8] = {'T', 'T', 'T', '4', 'x', '4', 'v', '1'};
+const int TABLE_HEADER_4X4 = 16;
+
+//a mask's position number with all of its digits 1, so a position is ternaryIndex(x) +
+//2 * ternaryIndex(o)
+inline unsigned int ternaryIndex(unsigned int mask) {
+    unsigned int index = 0;
+    unsigned int power = 1;
+    for (int square = 0; square < SQUARES_4X4; ++square) {
+        index += ((mask >> square) & 1) ? power : 0;
+        power *= 3;
+    }
+    return index;
+}
+
+//whether one side's pieces, as a mask, make four in a row, by the game's own rule: the pieces go
+//on the 4,4,4 MnkBoard tictactoe4x4 plays on, whose Place spots the line as it's completed
+inline bool isWin4x4(unsigned int mask) {
+    MnkBoard board(SIDE_4X4, SIDE_4X4, SIDE_4X4);
+    for (unsigned int pieces = mask; pieces != 0; pieces &= pieces - 1) {
+        board.Place(__builtin_ctz(pieces), X);
+    }
+    return board.Winner() == X;
+}
+
+//retrograde analysis: a full board is decided, and every other position's outcome follows from
+//the positions one move on, so the solver works back from 16 pieces to none. the positions with
+//the same number of pieces don't depend on each other, so each level is shared between threads,
+//each taking its own run of X masks, and every thread only writes its own positions' bytes while
+//reading the finished level above. the outcomes are a byte a position while solving, 43 MB, and
+//packed to two bits a position, 11 MB, when written out. whether a side has a line is looked up
+//in a table of every mask, filled in once from the game's board by isWin4x4
+class Solver4x4 {
+    public:
+        Solver4x4();
+        //whether a game can reach the position, as for the 3 by 3 EndgameTable: X moves first, so X
+        //has as many pieces as O or one more, and the game stops at the first line, so only the
+        //side that moved last can have one
+        bool isPosition(unsigned int x, unsigned int o) const;
+        //solves every position
+        void Solve(int numThreads);
+        Outcome GetOutcome(unsigned int x, unsigned int o) const;
+        //how many positions have the outcome
+        long long Count(Outcome outcome) const;
+        //writes the packed table, false if the file can't be written
+        bool Write(const std::string& path) const;
+    private:
+        //the positions with this many pieces whose X masks this thread takes
+        void SolveLevel(int pieces, int thread, int numThreads);
+
+        std::vector<unsigned char> m_Outcomes;
+        std::vector<unsigned int> m_Ternary;
+        std::vector<bool> m_isWin;
+        unsigned int m_Powers[SQUARES_4X4];
+};
+
+inline Solver4x4::Solver4x4(): m_Outcomes(POSITIONS_4X4, NOT_A_POSITION), m_Ternary(ALL_SQUARES_4X4 + 1),
+    m_isWin(ALL_SQUARES_4X4 + 1) {
+    for (unsigned int mask = 0; mask <= ALL_SQUARES_4X4; ++mask) {
+        m_Ternary[mask] = ternaryIndex(mask);
+        m_isWin[mask] = isWin4x4(mask);
+    }
+    for (int square = 0; square < SQUARES_4X4; ++square) {
+        m_Powers[square] = ternaryIndex(1u << square);
+    }
+}
+
+inline bool Solver4x4::isPosition(unsigned int x, unsigned int o) const {
+    int numX = __builtin_popcount(x);
+    int numO = __builtin_popcount(o);
+    if ((x & o) != 0 || (numX != numO && numX != numO + 1)) {
+        return false;
+    }
+    //X moved last if it has the extra piece, and O otherwise
+    bool isXLast = (numX > numO);
+    return !(isXLast ? m_isWin[o] : m_isWin[x]);
+}
+
+inline void Solver4x4::Solve(int numThreads) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    for (int pieces = SQUARES_4X4; pieces >= 0; --pieces) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.push_back(std::thread(&Solver4x4::SolveLevel, this, pieces, t, numThreads));
+        }
+        for (int t = 0; t < numThreads; ++t) {
+            threads[t].join();
+        }
+    }
+}
+
+inline void Solver4x4::SolveLevel(int pieces, int thread, int numThreads) {
+    //X moves first, so X has made as many moves as O when it's X's turn, and one more otherwise
+    int numX = (pieces + 1) / 2;
+    int numO = pieces / 2;
+    bool isXTurn = (numX == numO);
+    //every X mask with numX pieces in this thread's run of masks. neighbouring masks are
+    //neighbouring positions, so a run keeps each thread writing its own stretch of the table rather
+    //than sharing cache lines with the others
+    unsigned int first = (ALL_SQUARES_4X4 + 1) * thread / numThreads;
+    unsigned int last = (ALL_SQUARES_4X4 + 1) * (thread + 1) / numThreads;
+    for (unsigned int x = first; x < last; ++x) {
+        if (__builtin_popcount(x) != numX) {
+            continue;
+        }
+        unsigned int free = ALL_SQUARES_4X4 & ~x;
+        //every O mask with numO pieces among the squares X doesn't hold
+        for (unsigned int o = free; ; o = (o - 1) & free) {
+            //positions no game reaches keep NOT_A_POSITION, and every move from one that can be
+            //reached leads to another that can
+            if (__builtin_popcount(o) == numO && isPosition(x, o)) {
+                unsigned int index = m_Ternary[x] + 2 * m_Ternary[o];
+                unsigned int theirs = isXTurn ? o : x;
+                unsigned int empty = free & ~o;
+                Outcome outcome;
+                if (m_isWin[theirs]) {
+                    outcome = LOSS;
+                }
+                else if (empty == 0) {
+                    outcome = DRAW;
+                }
+                else {
+                    //the best of the moves, each an outcome for the other side
+                    outcome = LOSS;
+                    unsigned int digit = isXTurn ? 1 : 2;
+                    for (unsigned int moves = empty; moves != 0 && outcome != WIN; moves &= moves - 1) {
+                        int square = __builtin_ctz(moves);
+                        unsigned char reply = m_Outcomes[index + digit * m_Powers[square]];
+                        if (reply == LOSS) {
+                            outcome = WIN;
+                        }
+                        else if (reply == DRAW) {
+                            outcome = DRAW;
+                        }
+                    }
+                }
+                m_Outcomes[index] = static_cast<unsigned char>(outcome);
+            }
+            if (o == 0) {
+                break;
+            }
+        }
+    }
+}
+
+inline Outcome Solver4x4::GetOutcome(unsigned int x, unsigned int o) const {
+    return static_cast<Outcome>(m_Outcomes[m_Ternary[x] + 2 * m_Ternary[o]]);
+}
+
+inline long long Solver4x4::Count(Outcome outcome) const {
+    long long count = 0;
+    for (int i = 0; i < POSITIONS_4X4; ++i) {
+        count += (m_Outcomes[i] == outcome) ? 1 : 0;
+    }
+    return count;
+}
+
+inline bool Solver4x4::Write(const std::string& path) const {
+    std::vector<unsigned char> packed((POSITIONS_4X4 + 3) / 4, 0);
+    for (int i = 0; i < POSITIONS_4X4; ++i) {
+        packed[i / 4] |= static_cast<unsigned char>(m_Outcomes[i] << (2 * (i % 4)));
+    }
+    unsigned char header[TABLE_HEADER_4X4];
+    std::memcpy(header, TABLE_MAGIC_4X4, sizeof(TABLE_MAGIC_4X4));
+    std::uint64_t count = POSITIONS_4X4;
+    for (int i = 0; i < 8; ++i) {
+        header[8 + i] = static_cast<unsigned char>(count >> (8 * i));
+    }
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&packed[0]), packed.size());
+    //closing flushes the last of the file, which can fail too
+    file.close();
+    return !file.fail();
+}
+
+//the solved table, read straight from its file by mapping it into memory: opening it costs
+//nothing however big it is, and the operating system only reads in the pages a game looks at
+class MappedTable4x4 {
+    public:
+        MappedTable4x4();
+        ~MappedTable4x4();
+        //maps the file, false if it can't be opened or isn't a whole table
+        bool Open(const std::string& path);
+        bool isOpen() const;
+        Outcome GetOutcome(unsigned int x, unsigned int o) const;
+    private:
+        //the mapping can't be shared or copied
+        MappedTable4x4(const MappedTable4x4&);
+        MappedTable4x4& operator=(const MappedTable4x4&);
+
+        void* m_pMapping;
+        std::size_t m_Size;
+        const unsigned char* m_pOutcomes;
+};
+
+inline MappedTable4x4::MappedTable4x4(): m_pMapping(0), m_Size(0), m_pOutcomes(0) {}
+
+inline MappedTable4x4::~MappedTable4x4() {
+    if (m_pMapping != 0) {
+        munmap(m_pMapping, m_Size);
+    }
+}
+
+inline bool MappedTable4x4::Open(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    std::size_t expected = TABLE_HEADER_4X4 + (POSITIONS_4X4 + 3) / 4;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != expected) {
+        close(fd);
+        return false;
+    }
+    //the mapping keeps the file open, so the descriptor isn't needed once it's made
+    void* pMapping = mmap(0, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pMapping == MAP_FAILED) {
+        return false;
+    }
+    const unsigned char* pBytes = static_cast<const unsigned char*>(pMapping);
+    std::uint64_t count = 0;
+    for (int i = 0; i < 8; ++i) {
+        count |= static_cast<std::uint64_t>(pBytes[8 + i]) << (8 * i);
+    }
+    if (std::memcmp(pBytes, TABLE_MAGIC_4X4, sizeof(TABLE_MAGIC_4X4)) != 0 || count != POSITIONS_4X4) {
+        munmap(pMapping, expected);
+        return false;
+    }
+    m_pMapping = pMapping;
+    m_Size = expected;
+    m_pOutcomes = pBytes + TABLE_HEADER_4X4;
+    return true;
+}
+
+inline bool MappedTable4x4::isOpen() const {
+    return m_pOutcomes != 0;
+}
+
+inline Outcome MappedTable4x4::GetOutcome(unsigned int x, unsigned int o) const {
+    unsigned int index = ternaryIndex(x) + 2 * ternaryIndex(o);
+    return static_cast<Outcome>((m_pOutcomes[index / 4] >> (2 * (index % 4))) & 3);
+}
+
+#endif
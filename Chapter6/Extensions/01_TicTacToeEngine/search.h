@@ -0,0 +1,184 @@
+//Search
+//A Tic-Tac-Toe player that never loses: negamax with alpha-beta pruning and a transposition table
+
+#ifndef TICTACTOE_SEARCH_H
+#define TICTACTOE_SEARCH_H
+
+#include <vector>
+
+#include "board.h"
+#include "symmetry.h"
+
+//what a search found: the move to make, how the game ends with best play from both sides, and
+//how many positions it looked at
+struct SearchResult {
+    //the square to take, or -1 if the game is already over
+    int move;
+    //0 for a draw; a win for the side to move scores 1 more than the number of squares still
+    //empty when it's won, so a quicker win scores higher, and a loss is the negative of that
+    int score;
+    long long nodes;
+};
+
+//searches the whole game tree from a position, with alpha-beta cutting off moves that can't
+//change the result. each position's result is remembered in a fixed size, direct mapped
+//transposition table, so a position reached by a different order of moves isn't searched again,
+//and the table carries over from move to move. the table is keyed on the position's canonical
+//form, so a position and its seven turns and flips share one entry, and the best move is kept
+//turned the same way and turned back when it's used. an Engine never allocates
+class Engine {
+    public:
+        Engine();
+        //the best move for piece on the board, the quickest win or else a draw, and its score
+        SearchResult Search(const Board& board, char piece);
+        //just the move
+        int BestMove(const Board& board, char piece);
+        //forgets every remembered position
+        void ClearTable();
+    private:
+        //765 canonical positions against 5478 in all, so an eighth of the entries will do
+        static const int TABLE_BITS = 10;
+        static const int TABLE_SIZE = 1 << TABLE_BITS;
+        //the score is exact, or only a bound because a cutoff stopped the search early
+        enum Bound {EXACT, LOWER, UPPER};
+
+        struct Entry {
+            //the canonical position's two masks plus one, 0 for an unused entry
+            unsigned int key;
+            signed char score;
+            unsigned char bound;
+            //in the canonical position
+            signed char move;
+        };
+
+        //the score of the position for the side holding mine, whose turn it is
+        int Negamax(unsigned int mine, unsigned int theirs, int alpha, int beta, int& bestMove);
+        //the canonical key, and the symmetry that turns this position into it
+        static unsigned int Key(unsigned int mine, unsigned int theirs, int& symmetry);
+        static int Index(unsigned int key);
+
+        Entry m_Table[TABLE_SIZE];
+        long long m_Nodes;
+};
+
+//squares to try first, the book's BEST_MOVES, so the strongest replies cut the search off soonest
+const int MOVE_ORDER[NUM_SQUARES] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+constexpr MaskSymmetries<3> SYMMETRIES;
+
+inline Engine::Engine(): m_Nodes(0) {
+    ClearTable();
+}
+
+inline void Engine::ClearTable() {
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        m_Table[i].key = 0;
+    }
+}
+
+inline unsigned int Engine::Key(unsigned int mine, unsigned int theirs, int& symmetry) {
+    return static_cast<unsigned int>(SYMMETRIES.Canonical(mine, theirs, symmetry)) + 1;
+}
+
+inline int Engine::Index(unsigned int key) {
+    //Fibonacci hashing, the top bits of the key times 2^32 / golden ratio
+    return static_cast<int>((key * 0x9E3779B1u) >> (32 - TABLE_BITS));
+}
+
+inline SearchResult Engine::Search(const Board& board, char piece) {
+    char other = (piece == X) ? O : X;
+    SearchResult result;
+    m_Nodes = 0;
+    result.score = Negamax(board.GetMask(piece), board.GetMask(other), -NUM_SQUARES - 1, NUM_SQUARES + 1,
+                           result.move);
+    result.nodes = m_Nodes;
+    return result;
+}
+
+inline int Engine::BestMove(const Board& board, char piece) {
+    return Search(board, piece).move;
+}
+
+inline int Engine::Negamax(unsigned int mine, unsigned int theirs, int alpha, int beta, int& bestMove) {
+    ++m_Nodes;
+    bestMove = -1;
+    unsigned int empty = ALL_SQUARES & ~(mine | theirs);
+    //the other side moved last, so only they can have just won
+    if (WIN_TABLE.isWin[theirs]) {
+        return -(1 + __builtin_popcount(empty));
+    }
+    if (empty == 0) {
+        return 0;
+    }
+
+    int symmetry;
+    unsigned int key = Key(mine, theirs, symmetry);
+    Entry& entry = m_Table[Index(key)];
+    int firstMove = -1;
+    if (entry.key == key) {
+        firstMove = SYMMETRIES.GetSquares().Unmap(symmetry, entry.move);
+        if (entry.bound == EXACT) {
+            bestMove = firstMove;
+            return entry.score;
+        }
+        if (entry.bound == LOWER && entry.score > alpha) {
+            alpha = entry.score;
+        }
+        else if (entry.bound == UPPER && entry.score < beta) {
+            beta = entry.score;
+        }
+        if (alpha >= beta) {
+            bestMove = firstMove;
+            return entry.score;
+        }
+    }
+
+    int originalAlpha = alpha;
+    int best = -NUM_SQUARES - 1;
+    int reply;
+    //the remembered best move first, then the rest in MOVE_ORDER
+    for (int i = -1; i < NUM_SQUARES; ++i) {
+        int move = (i < 0) ? firstMove : MOVE_ORDER[i];
+        if (move < 0 || (i >= 0 && move == firstMove) || ((empty >> move) & 1) == 0) {
+            continue;
+        }
+        int score = -Negamax(theirs, mine | (1u << move), -beta, -alpha, reply);
+        if (score > best) {
+            best = score;
+            bestMove = move;
+        }
+        if (best > alpha) {
+            alpha = best;
+        }
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    entry.key = key;
+    entry.score = static_cast<signed char>(best);
+    entry.move = static_cast<signed char>(SYMMETRIES.GetSquares().Map(symmetry, bestMove));
+    if (best <= originalAlpha) {
+        entry.bound = UPPER;
+    }
+    else if (best >= beta) {
+        entry.bound = LOWER;
+    }
+    else {
+        entry.bound = EXACT;
+    }
+    return best;
+}
+
+//the best move for computer, for programs that keep the book's board; one engine is kept for the
+//whole program so its table carries over from move to move
+inline int bestMove(const Board& board, char computer) {
+    static Engine engine;
+    return engine.BestMove(board, computer);
+}
+
+inline int bestMove(const std::vector<char>& board, char computer) {
+    return bestMove(Board(board), computer);
+}
+
+#endif
@@ -0,0 +1,143 @@
+//Solve 4x4
+//Solves every position of 4 by 4 Tic-Tac-Toe by retrograde analysis, checks a sample of them
+//against a plain search, and writes the table for tictactoe4x4 to map
+//usage: solve4x4 [-t threads] [-o file]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../../../Common/rng.h"
+#include "mnkBoard.h"
+#include "retrograde.h"
+
+using namespace std;
+
+Outcome searchOutcome(MnkBoard& board, char turn);
+bool checkSample(const Solver4x4& solver, int numPositions);
+void usage();
+
+int main(int argc, char* argv[]) {
+    int numThreads = thread::hardware_concurrency();
+    string path = "tictactoe4x4.table";
+
+    for (int i = 1; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-t") {
+            numThreads = atoi(value);
+        }
+        else if (flag == "-o") {
+            path = value;
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+
+    cout << "solving " << POSITIONS_4X4 << " positions on " << numThreads << " thread";
+    cout << (numThreads == 1 ? "" : "s") << "\n";
+    Solver4x4 solver;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    solver.Solve(numThreads);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "solved in " << elapsed.count() << " s\n";
+    cout << "  wins for the side to move:   " << solver.Count(WIN) << "\n";
+    cout << "  draws:                       " << solver.Count(DRAW) << "\n";
+    cout << "  losses for the side to move: " << solver.Count(LOSS) << "\n";
+    cout << "  positions no game reaches:   " << solver.Count(NOT_A_POSITION) << "\n";
+
+    const char* NAMES[] = {"a loss for X", "a draw", "a win for X"};
+    Outcome empty = solver.GetOutcome(0, 0);
+    cout << "the empty board is " << NAMES[empty] << "\n";
+    if (empty != DRAW || !checkSample(solver, 2000)) {
+        cerr << "the table is wrong\n";
+        return 1;
+    }
+
+    if (!solver.Write(path)) {
+        cerr << "couldn't write " << path << "\n";
+        return 1;
+    }
+    cout << "wrote " << path << "\n";
+    return 0;
+}
+
+//the outcome for the side to move, turn, by trying every move to the end of the game on the board
+//the game is played on, with its own isLegal and Winner
+Outcome searchOutcome(MnkBoard& board, char turn) {
+    char winner = board.Winner();
+    if (winner != NO_ONE) {
+        //the side that just moved made a line, or filled the board
+        return (winner == TIE) ? DRAW : LOSS;
+    }
+    char next = (turn == X) ? O : X;
+    Outcome best = LOSS;
+    for (int move = 0; move < SQUARES_4X4 && best != WIN; ++move) {
+        if (board.isLegal(move)) {
+            board.Place(move, turn);
+            Outcome reply = searchOutcome(board, next);
+            board.Remove(move);
+            if (reply == LOSS) {
+                best = WIN;
+            }
+            else if (reply == DRAW) {
+                best = DRAW;
+            }
+        }
+    }
+    return best;
+}
+
+//random games played to at least eight pieces, so each search is quick, and the positions they
+//reach checked against the table; then positions no game reaches, which the table must mark
+bool checkSample(const Solver4x4& solver, int numPositions) {
+    Rng rng(static_cast<unsigned long long>(POSITIONS_4X4));
+    for (int i = 0; i < numPositions; ++i) {
+        MnkBoard board(SIDE_4X4, SIDE_4X4, SIDE_4X4);
+        int numPieces = 8 + static_cast<int>(rng.Below(SQUARES_4X4 - 7));
+        char turn = X;
+        while (board.GetNumPlaced() < numPieces && board.Winner() == NO_ONE) {
+            board.Place(board.GetEmpty(rng.Below(board.GetNumEmpty())), turn);
+            turn = (turn == X) ? O : X;
+        }
+        unsigned int pieces[2] = {0, 0};
+        for (int square = 0; square < SQUARES_4X4; ++square) {
+            if (board.GetSquare(square) != EMPTY) {
+                pieces[board.GetSquare(square) == X ? 0 : 1] |= 1u << square;
+            }
+        }
+        Outcome expected = searchOutcome(board, turn);
+        if (solver.GetOutcome(pieces[0], pieces[1]) != expected) {
+            cerr << "position x " << pieces[0] << ", o " << pieces[1] << ": table ";
+            cerr << solver.GetOutcome(pieces[0], pieces[1]) << ", search " << expected << "\n";
+            return false;
+        }
+    }
+    cout << numPositions << " random positions agree with a full search\n";
+
+    //O to move with more pieces than X; both sides with a line; O with a line after X moved last
+    const int NUM_UNREACHABLE = 3;
+    const unsigned int UNREACHABLE[NUM_UNREACHABLE][2] = {{0x0001, 0x0006}, {0x100F, 0x00F0}, {0x0307, 0x00F0}};
+    for (int i = 0; i < NUM_UNREACHABLE; ++i) {
+        if (solver.GetOutcome(UNREACHABLE[i][0], UNREACHABLE[i][1]) != NOT_A_POSITION) {
+            cerr << "position x " << UNREACHABLE[i][0] << ", o " << UNREACHABLE[i][1] << " can't be reached\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void usage() {
+    cerr << "usage: solve4x4 [-t threads] [-o file]\n";
+}
@@ -0,0 +1,136 @@
+//Symmetry
+//The eight ways to turn or flip a square board onto itself, and each position's canonical form
+
+#ifndef TICTACTOE_SYMMETRY_H
+#define TICTACTOE_SYMMETRY_H
+
+#include <cstdint>
+
+//turning a position a quarter turn, or flipping it over, gives a position that plays exactly the
+//same, with its moves turned or flipped the same way. a square board has eight of these
+//symmetries: none, a quarter, half and three quarter turn, and each of those followed by a flip
+//from left to right. this is where each one sends each square, and back, for a SIDE by SIDE board
+//numbered along its rows, filled in by the compiler
+template <int SIDE>
+class Symmetries {
+    public:
+        static const int NUM_SYMMETRIES = 8;
+        static const int AREA = SIDE * SIDE;
+
+        constexpr Symmetries();
+        //where the symmetry moves a square to
+        constexpr int Map(int symmetry, int square) const;
+        //the square the symmetry moves onto this one, undoing Map
+        constexpr int Unmap(int symmetry, int square) const;
+    private:
+        short m_Map[NUM_SYMMETRIES][AREA];
+        short m_Unmap[NUM_SYMMETRIES][AREA];
+};
+
+template <int SIDE>
+constexpr Symmetries<SIDE>::Symmetries(): m_Map(), m_Unmap() {
+    for (int symmetry = 0; symmetry < NUM_SYMMETRIES; ++symmetry) {
+        for (int square = 0; square < AREA; ++square) {
+            int row = square / SIDE;
+            int column = square % SIDE;
+            //a quarter turn clockwise at a time
+            for (int turn = 0; turn < (symmetry & 3); ++turn) {
+                int turned = column;
+                column = SIDE - 1 - row;
+                row = turned;
+            }
+            if (symmetry & 4) {
+                column = SIDE - 1 - column;
+            }
+            int mapped = row * SIDE + column;
+            m_Map[symmetry][square] = static_cast<short>(mapped);
+            m_Unmap[symmetry][mapped] = static_cast<short>(square);
+        }
+    }
+}
+
+template <int SIDE>
+constexpr int Symmetries<SIDE>::Map(int symmetry, int square) const {
+    return m_Map[symmetry][square];
+}
+
+template <int SIDE>
+constexpr int Symmetries<SIDE>::Unmap(int symmetry, int square) const {
+    return m_Unmap[symmetry][square];
+}
+
+//the same symmetries for boards held as bitmasks, square i as bit i. moving every bit of a mask
+//one at a time would cost a loop per mask, so a mask is split into bytes, and for each symmetry
+//and byte a 256 entry table holds where that byte's squares go; a whole mask is then one lookup
+//per byte, ORed together. a position's canonical form is the smallest of its eight keys, so all
+//eight positions share one key and one entry in a search's table
+template <int SIDE>
+class MaskSymmetries {
+    public:
+        static const int NUM_SYMMETRIES = Symmetries<SIDE>::NUM_SYMMETRIES;
+        static const int AREA = SIDE * SIDE;
+        static_assert(AREA <= 32, "a side's squares have to fit in an unsigned int");
+
+        constexpr MaskSymmetries();
+        //the mask with every square moved by the symmetry
+        unsigned int MapMask(int symmetry, unsigned int mask) const;
+        //the smallest of the position's eight keys, mine's mask in the low bits and theirs above
+        //it, and the symmetry that gives it; a move in the canonical position is Map of the move
+        //in this one
+        std::uint64_t Canonical(unsigned int mine, unsigned int theirs, int& symmetry) const;
+        //where the symmetries send single squares
+        const Symmetries<SIDE>& GetSquares() const;
+    private:
+        static const int NUM_BYTES = (AREA + 7) / 8;
+
+        Symmetries<SIDE> m_Squares;
+        unsigned int m_Bytes[NUM_SYMMETRIES][NUM_BYTES][256];
+};
+
+template <int SIDE>
+constexpr MaskSymmetries<SIDE>::MaskSymmetries(): m_Squares(), m_Bytes() {
+    for (int symmetry = 0; symmetry < NUM_SYMMETRIES; ++symmetry) {
+        for (int byte = 0; byte < NUM_BYTES; ++byte) {
+            for (int bits = 0; bits < 256; ++bits) {
+                unsigned int mapped = 0;
+                for (int bit = 0; bit < 8; ++bit) {
+                    int square = 8 * byte + bit;
+                    if (((bits >> bit) & 1) && square < AREA) {
+                        mapped |= 1u << m_Squares.Map(symmetry, square);
+                    }
+                }
+                m_Bytes[symmetry][byte][bits] = mapped;
+            }
+        }
+    }
+}
+
+template <int SIDE>
+inline unsigned int MaskSymmetries<SIDE>::MapMask(int symmetry, unsigned int mask) const {
+    unsigned int mapped = 0;
+    for (int byte = 0; byte < NUM_BYTES; ++byte) {
+        mapped |= m_Bytes[symmetry][byte][(mask >> (8 * byte)) & 0xFF];
+    }
+    return mapped;
+}
+
+template <int SIDE>
+inline std::uint64_t MaskSymmetries<SIDE>::Canonical(unsigned int mine, unsigned int theirs, int& symmetry) const {
+    std::uint64_t smallest = mine | (static_cast<std::uint64_t>(theirs) << AREA);
+    symmetry = 0;
+    for (int s = 1; s < NUM_SYMMETRIES; ++s) {
+        std::uint64_t key = MapMask(s, mine) | (static_cast<std::uint64_t>(MapMask(s, theirs)) << AREA);
+        if (key < smallest) {
+            smallest = key;
+            symmetry = s;
+        }
+    }
+    return smallest;
+}
+
+template <int SIDE>
+inline const Symmetries<SIDE>& MaskSymmetries<SIDE>::GetSquares() const {
+    return m_Squares;
+}
+
+#endif
@@ -0,0 +1,152 @@
+// TicTacToe
+// The book's game of tic-tac-toe, played on a bitmask Board against a computer that never loses
+
+#include <iostream>
+
+#include "board.h"
+#include "endgame.h"
+
+using namespace std;
+
+//function prototypes
+void instructions();
+char askYesNo(const char* question);
+int askNumber(const char* question, int high, int low = 0);
+char humanPiece();
+char opponent(char piece);
+void displayBoard(const Board& board);
+int humanMove(const Board& board);
+int computerMove(const Board& board, char computer);
+void announceWinner(char winner, char computer, char human);
+
+// main function
+int main() {
+    int move;
+    Board board;
+
+    instructions();
+    char human = humanPiece();
+    char computer = opponent(human);
+    char turn = X;
+    displayBoard(board);
+
+    while (board.Winner() == NO_ONE) {
+        if (turn == human) {
+            move = humanMove(board);
+            board.Place(move, human);
+        }
+        else {
+            move = computerMove(board, computer);
+            board.Place(move, computer);
+        }
+        displayBoard(board);
+        turn = opponent(turn);
+    }
+    announceWinner(board.Winner(), computer, human);
+    return 0;
+}
+
+void instructions() {
+    cout << "Welcome to the ultimate man-machine showdown: Tic-Tac-Toe\n";
+    cout << "--where human brain is pit against silicon processor\n\n";
+
+    cout << "Make your move known by entering a number, 0-8. The number\n";
+    cout << "corresponds to the desired board position, as illustrated:\n\n";
+
+    cout << "       0 | 1 | 2\n";
+    cout << "       ---------\n";
+    cout << "       3 | 4 | 5\n";
+    cout << "       ---------\n";
+    cout << "       6 | 7 | 8\n";
+    cout << "       ---------\n\n";
+
+    cout << "Prepare yourself, human. The battle is about to begin.\n\n";
+}
+
+char askYesNo(const char* question) {
+    char response;
+    do {
+        cout << question << "(y/n): ";
+        cin >> response;
+    } while (response != 'y' && response != 'n');
+
+    return response;
+}
+
+int askNumber(const char* question, int high, int low) {
+    int number;
+    do {
+        cout << question << " (" << low << " - " << high << " ): ";
+        cin >> number;
+    } while (number > high || number < low);
+
+    return number;
+}
+
+char humanPiece() {
+    char go_first = askYesNo("Do you require the first move?");
+    if (go_first == 'y') {
+        cout << "\nThen take the first move. You will need it.\n";
+        return X;
+    }
+    else {
+        cout << "\nYour bravery will be your undoing... I will go first.\n";
+        return O;
+    }
+}
+
+char opponent(char piece) {
+    if (piece == X) {
+        return O;
+    }
+    else {
+        return X;
+    }
+}
+
+void displayBoard(const Board& board) {
+    cout << "\n\t" << board.GetSquare(0) << " | " << board.GetSquare(1) << " | " << board.GetSquare(2);
+    cout << "\n\t" << "---------";
+    cout << "\n\t" << board.GetSquare(3) << " | " << board.GetSquare(4) << " | " << board.GetSquare(5);
+    cout << "\n\t" << "---------";
+    cout << "\n\t" << board.GetSquare(6) << " | " << board.GetSquare(7) << " | " << board.GetSquare(8);
+    cout << "\n\n";
+}
+
+int humanMove(const Board& board) {
+    int move = askNumber("Where will you move?", NUM_SQUARES - 1);
+    while (!board.isLegal(move)) {
+        cout << "\nThat square is already occupied, foolish human.\n";
+        move = askNumber("Where will you move?", NUM_SQUARES - 1);
+    }
+    cout << "Fine...\n";
+    return move;
+}
+
+//looks the best move up in the table of every position the compiler solved, rather than using
+//the book's win, block or best square heuristic. X always goes first, so the table knows whose
+//turn it is without being told
+int computerMove(const Board& board, char) {
+    int move = ENDGAME_TABLE.GetMove(board);
+    cout << "I shall take square number " << move << endl;
+    return move;
+}
+
+void announceWinner(char winner, char computer, char human) {
+    if (winner == computer) {
+        cout << winner << "'s won!\n";
+        cout << "As I predicted, human, I am triumphant once more -- proof\n";
+        cout << "that computers are superior to humans in all regards.\n";
+    }
+    else if (winner == human) {
+        cout << winner << "'s won!\n";
+        cout << "No, no! It cannot be! Somehow you tricked me, human.\n";
+        cout << "But never again! I the computer, so swear it!\n";
+    }
+
+    else {
+        cout << "It's a tie.\n";
+        cout << "You were most lucky, human, and somehow managed to tie me.\n";
+        cout << "Celebrate... for tis the best you will ever achieve.\n";
+    }
+}
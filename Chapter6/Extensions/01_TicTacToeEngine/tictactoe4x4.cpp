@@ -0,0 +1,187 @@
+// TicTacToe 4x4
+// The book's game of tic-tac-toe on a 4 by 4 board, four in a row to win, against a computer that
+// looks every move up in the table solve4x4 wrote
+// usage: tictactoe4x4 [table]
+
+#include <iostream>
+#include <string>
+
+#include "mnkBoard.h"
+#include "retrograde.h"
+
+using namespace std;
+
+//function prototypes
+void instructions();
+char askYesNo(const char* question);
+int askNumber(const char* question, int high, int low = 0);
+char humanPiece();
+char opponent(char piece);
+void displayBoard(const MnkBoard& board);
+int humanMove(const MnkBoard& board);
+int computerMove(const MnkBoard& board, char computer, const MappedTable4x4& table);
+void announceWinner(char winner, char computer, char human);
+
+// main function
+int main(int argc, char* argv[]) {
+    string path = (argc > 1) ? argv[1] : "tictactoe4x4.table";
+    //mapping the table reads none of it; the pages a game looks at are read in as it goes
+    MappedTable4x4 table;
+    if (argc > 2 || !table.Open(path)) {
+        cerr << "usage: tictactoe4x4 [table], where the table is written by solve4x4\n";
+        return 1;
+    }
+    int move;
+    MnkBoard board(SIDE_4X4, SIDE_4X4, SIDE_4X4);
+
+    instructions();
+    char human = humanPiece();
+    char computer = opponent(human);
+    char turn = X;
+    displayBoard(board);
+
+    while (board.Winner() == NO_ONE) {
+        if (turn == human) {
+            move = humanMove(board);
+            board.Place(move, human);
+        }
+        else {
+            move = computerMove(board, computer, table);
+            board.Place(move, computer);
+        }
+        displayBoard(board);
+        turn = opponent(turn);
+    }
+    announceWinner(board.Winner(), computer, human);
+    return 0;
+}
+
+void instructions() {
+    cout << "Welcome to the ultimate man-machine showdown: Tic-Tac-Toe, four in a row\n";
+    cout << "--where human brain is pit against silicon processor\n\n";
+
+    cout << "Make your move known by entering a number, 0-15. The number\n";
+    cout << "corresponds to the desired board position, as illustrated:\n\n";
+
+    cout << "        0 |  1 |  2 |  3\n";
+    cout << "       -----------------\n";
+    cout << "        4 |  5 |  6 |  7\n";
+    cout << "       -----------------\n";
+    cout << "        8 |  9 | 10 | 11\n";
+    cout << "       -----------------\n";
+    cout << "       12 | 13 | 14 | 15\n\n";
+
+    cout << "Prepare yourself, human. The battle is about to begin.\n\n";
+}
+
+char askYesNo(const char* question) {
+    char response;
+    do {
+        cout << question << "(y/n): ";
+        cin >> response;
+    } while (response != 'y' && response != 'n');
+
+    return response;
+}
+
+int askNumber(const char* question, int high, int low) {
+    int number;
+    do {
+        cout << question << " (" << low << " - " << high << " ): ";
+        cin >> number;
+    } while (number > high || number < low);
+
+    return number;
+}
+
+char humanPiece() {
+    char go_first = askYesNo("Do you require the first move?");
+    if (go_first == 'y') {
+        cout << "\nThen take the first move. You will need it.\n";
+        return X;
+    }
+    else {
+        cout << "\nYour bravery will be your undoing... I will go first.\n";
+        return O;
+    }
+}
+
+char opponent(char piece) {
+    if (piece == X) {
+        return O;
+    }
+    else {
+        return X;
+    }
+}
+
+void displayBoard(const MnkBoard& board) {
+    for (int row = 0; row < SIDE_4X4; ++row) {
+        if (row > 0) {
+            cout << "\n\t" << "-------------";
+        }
+        cout << "\n\t";
+        for (int column = 0; column < SIDE_4X4; ++column) {
+            cout << (column > 0 ? " | " : "") << board.GetSquare(row * SIDE_4X4 + column);
+        }
+    }
+    cout << "\n\n";
+}
+
+int humanMove(const MnkBoard& board) {
+    int move = askNumber("Where will you move?", SQUARES_4X4 - 1);
+    while (!board.isLegal(move)) {
+        cout << "\nThat square is already occupied, foolish human.\n";
+        move = askNumber("Where will you move?", SQUARES_4X4 - 1);
+    }
+    cout << "Fine...\n";
+    return move;
+}
+
+//the move that leaves the human lost if there is one, otherwise one that holds the draw. each
+//move's outcome is a lookup in the mapped table, for the human to move after it
+int computerMove(const MnkBoard& board, char computer, const MappedTable4x4& table) {
+    unsigned int pieces[2] = {0, 0};
+    for (int square = 0; square < SQUARES_4X4; ++square) {
+        if (board.GetSquare(square) != EMPTY) {
+            pieces[board.GetSquare(square) == X ? 0 : 1] |= 1u << square;
+        }
+    }
+    int side = (computer == X) ? 0 : 1;
+    int move = -1;
+    Outcome best = NOT_A_POSITION;
+    for (int square = 0; square < SQUARES_4X4; ++square) {
+        if (!board.isLegal(square)) {
+            continue;
+        }
+        pieces[side] |= 1u << square;
+        Outcome reply = table.GetOutcome(pieces[0], pieces[1]);
+        pieces[side] &= ~(1u << square);
+        //the human's outcome, so the smaller the better
+        if (move < 0 || reply < best) {
+            move = square;
+            best = reply;
+        }
+    }
+    cout << "I shall take square number " << move << endl;
+    return move;
+}
+
+void announceWinner(char winner, char computer, char human) {
+    if (winner == computer) {
+        cout << winner << "'s won!\n";
+        cout << "As I predicted, human, I am triumphant once more -- proof\n";
+        cout << "that computers are superior to humans in all regards.\n";
+    }
+    else if (winner == human) {
+        cout << winner << "'s won!\n";
+        cout << "No, no! It cannot be! Somehow you tricked me, human.\n";
+        cout << "But never again! I the computer, so swear it!\n";
+    }
+
+    else {
+        cout << "It's a tie.\n";
+        cout << "You were most lucky, human, and somehow managed to tie me.\n";
+        cout << "Celebrate... for tis the best you will ever achieve.\n";
+    }
+}
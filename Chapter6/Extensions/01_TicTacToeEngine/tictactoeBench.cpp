@@ -0,0 +1,853 @@
+//TicTacToe Benchmarks
+//Checks the engine against the book's code over every reachable position, and times them both,
+//then does the same for the m,n,k board and its Monte Carlo player
+//usage: tictactoeBench [iterations]
+
+#include <algorithm>
+#include <set>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../../Common/allocationCounter.h"
+#include "board.h"
+#include "endgame.h"
+#include "lineBoard.h"
+#include "mcts.h"
+#include "mnkBoard.h"
+#include "search.h"
+#include "symmetry.h"
+#include "tournament.h"
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start);
+char bookWinner(const vector<char>& board);
+void addPositions(Board& board, char turn, vector<Board>& positions);
+bool benchWinner(const vector<Board>& positions, long long iterations);
+int bookComputerMove(vector<char> board, char computer);
+int bookMove(const Board& board, char computer);
+char sideToMove(const Board& board);
+int minimax(Board& board, char turn);
+void playEveryLine(Board& board, char turn, char computer, int (*choose)(const Board&, char), long long& games,
+                   long long& losses);
+bool benchLines(const vector<Board>& positions);
+template <int SIDE>
+bool checkSymmetries();
+bool benchSymmetry(const vector<Board>& positions);
+bool benchSearch(const vector<Board>& positions);
+bool benchEndgame(const vector<Board>& positions);
+bool sameWinners(Board& board, MnkBoard& mnk, char turn, long long& games);
+bool benchMcts();
+void stringPrompt(ostream& out, const string& question, int high, int low);
+void prompt(ostream& out, const char* question, int high, int low);
+bool benchAllocations(const vector<Board>& positions);
+
+int main(int argc, char* argv[]) {
+    long long iterations = (argc > 1) ? atoll(argv[1]) : 10000000;
+    if (iterations < 1) {
+        cerr << "usage: tictactoeBench [iterations]\n";
+        return 1;
+    }
+    //every position a game can reach, each once
+    Board empty;
+    vector<Board> positions;
+    addPositions(empty, X, positions);
+    cout << positions.size() << " reachable positions\n\n";
+
+    if (!benchWinner(positions, iterations)) {
+        return 1;
+    }
+    if (!benchLines(positions)) {
+        return 1;
+    }
+    if (!benchSymmetry(positions)) {
+        return 1;
+    }
+    if (!benchSearch(positions)) {
+        return 1;
+    }
+    if (!benchEndgame(positions)) {
+        return 1;
+    }
+    if (!benchMcts()) {
+        return 1;
+    }
+    if (!benchAllocations(positions)) {
+        return 1;
+    }
+    return 0;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//the book's winner, unchanged
+char bookWinner(const vector<char>& board) {
+    // all possible winning rows
+    const int TOTAL_ROWS = 8;
+    const int WINNING_ROWS[TOTAL_ROWS][3] = { {0, 1, 2},
+                                            {3, 4, 5},
+                                            {6, 7, 8},
+                                            {0, 3, 6},
+                                            {1, 4, 7},
+                                            {2, 5, 8},
+                                            {0, 4, 8},
+                                            {2, 4, 6}};
+
+    // if any winning row has three values that are the same (and non-empty)
+    // then we have a winner
+
+    for (int row = 0; row < TOTAL_ROWS; ++row) {
+        if ((board[WINNING_ROWS[row][0]]) != EMPTY &&
+            (board[WINNING_ROWS[row][0]] == board[WINNING_ROWS[row][1]]) &&
+            (board[WINNING_ROWS[row][1]]) == board[WINNING_ROWS[row][2]]) {
+                return board[WINNING_ROWS[row][0]];
+            }
+    }
+
+    // since nobody has won, check for a tie (no empty squares left)
+    if (count(board.begin(), board.end(), EMPTY) == 0) {
+        return TIE;
+    }
+    //since nobody won and not a tie, game continues
+    return NO_ONE;
+}
+
+//adds the position and every position reachable from it that isn't already in the list; the
+//game stops at a win or a full board, so those positions have no children
+void addPositions(Board& board, char turn, vector<Board>& positions) {
+    if (find(positions.begin(), positions.end(), board) != positions.end()) {
+        return;
+    }
+    positions.push_back(board);
+    if (board.Winner() != NO_ONE) {
+        return;
+    }
+    for (int move = 0; move < NUM_SQUARES; ++move) {
+        if (board.isLegal(move)) {
+            board.Place(move, turn);
+            addPositions(board, (turn == X) ? O : X, positions);
+            board.Remove(move);
+        }
+    }
+}
+
+//the table lookup and the line masks against the book's winner on every reachable position, then
+//the cost of each asking about the positions over and over
+bool benchWinner(const vector<Board>& positions, long long iterations) {
+    int numPositions = static_cast<int>(positions.size());
+    vector<vector<char> > bookBoards(numPositions, vector<char>(NUM_SQUARES, EMPTY));
+    for (int p = 0; p < numPositions; ++p) {
+        for (int square = 0; square < NUM_SQUARES; ++square) {
+            bookBoards[p][square] = positions[p].GetSquare(square);
+        }
+        char expected = bookWinner(bookBoards[p]);
+        if (positions[p].Winner() != expected || positions[p].WinnerByLines() != expected ||
+            Board(bookBoards[p]) != positions[p]) {
+            cout << "winner: position " << p << " doesn't match the book\n";
+            return false;
+        }
+    }
+    cout << "winner: every position matches the book's winner\n";
+
+    //whole passes over the positions, so there's no division picking each one
+    long long passes = iterations / numPositions + 1;
+    long long calls = passes * numPositions;
+    long long checksums[3] = {0, 0, 0};
+    double seconds[3];
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        for (int p = 0; p < numPositions; ++p) {
+            checksums[0] += bookWinner(bookBoards[p]);
+        }
+    }
+    seconds[0] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        for (int p = 0; p < numPositions; ++p) {
+            checksums[1] += positions[p].WinnerByLines();
+        }
+    }
+    seconds[1] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (long long pass = 0; pass < passes; ++pass) {
+        for (int p = 0; p < numPositions; ++p) {
+            checksums[2] += positions[p].Winner();
+        }
+    }
+    seconds[2] = secondsSince(start);
+
+    const char* NAMES[] = {"book (vector<char>)", "line masks         ", "win table          "};
+    for (int w = 0; w < 3; ++w) {
+        cout << "        " << NAMES[w] << ": " << 1e9 * seconds[w] / calls << " ns/call (";
+        cout << seconds[0] / seconds[w] << "x)\n";
+    }
+    if (checksums[1] != checksums[0] || checksums[2] != checksums[0]) {
+        cout << "winner: the timed runs disagree\n";
+        return false;
+    }
+    return true;
+}
+
+//the book's computerMove without its message
+int bookComputerMove(vector<char> board, char computer) {
+    unsigned int move = 0;
+    bool found = false;
+    //if computer has a winning move, then computer makes that move
+    while (!found && move < board.size()) {
+        if (board[move] == EMPTY) {
+            board[move] = computer;
+            found = bookWinner(board) == computer;
+            board[move] = EMPTY;
+        }
+        if (!found) {
+            ++move;
+        }
+    }
+    //otherwise, if human can win on next move, that's the move to make
+    if (!found) {
+        move = 0;
+        char human = (computer == X) ? O : X;
+        while (!found && move < board.size()) {
+            if (board[move] == EMPTY) {
+                board[move] = human;
+                found = bookWinner(board) == human;
+                board[move] = EMPTY;
+            }
+            if (!found) {
+                ++move;
+            }
+        }
+    }
+    //otherwise, moving to the best open square is the move to make
+    if (!found) {
+        move = 0;
+        unsigned int i = 0;
+        const int BEST_MOVES[] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+        while (!found && i < board.size()) {
+            move = BEST_MOVES[i];
+            if (board[move] == EMPTY) {
+                found = true;
+            }
+            ++i;
+        }
+    }
+    return move;
+}
+
+int bookMove(const Board& board, char computer) {
+    vector<char> squares(NUM_SQUARES);
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        squares[square] = board.GetSquare(square);
+    }
+    return bookComputerMove(squares, computer);
+}
+
+//X goes first, so it's X's turn whenever both sides have made the same number of moves
+char sideToMove(const Board& board) {
+    return (__builtin_popcount(board.GetMask(X)) == __builtin_popcount(board.GetMask(O))) ? X : O;
+}
+
+//the plainest possible search, every move to the end of the game, scored the same way as Engine
+int minimax(Board& board, char turn) {
+    char other = (turn == X) ? O : X;
+    char result = board.Winner();
+    int numEmpty = __builtin_popcount(board.GetEmpty());
+    if (result == other) {
+        return -(1 + numEmpty);
+    }
+    if (result == TIE) {
+        return 0;
+    }
+    int best = -NUM_SQUARES - 1;
+    for (int move = 0; move < NUM_SQUARES; ++move) {
+        if (board.isLegal(move)) {
+            board.Place(move, turn);
+            best = max(best, -minimax(board, other));
+            board.Remove(move);
+        }
+    }
+    return best;
+}
+
+//plays out every game the opponent could choose against a computer choosing with the given
+//function, counting the games and the ones the computer lost
+void playEveryLine(Board& board, char turn, char computer, int (*choose)(const Board&, char), long long& games,
+                   long long& losses) {
+    char result = board.Winner();
+    if (result != NO_ONE) {
+        ++games;
+        losses += (result != TIE && result != computer) ? 1 : 0;
+        return;
+    }
+    char other = (turn == X) ? O : X;
+    if (turn == computer) {
+        int move = choose(board, computer);
+        board.Place(move, computer);
+        playEveryLine(board, other, computer, choose, games, losses);
+        board.Remove(move);
+        return;
+    }
+    for (int move = 0; move < NUM_SQUARES; ++move) {
+        if (board.isLegal(move)) {
+            board.Place(move, turn);
+            playEveryLine(board, other, computer, choose, games, losses);
+            board.Remove(move);
+        }
+    }
+}
+
+//the line counts against the bitmask board on every reachable position and every move from it,
+//with each move taken back again, and the book's computerMove on a LineBoard against the book's
+//own. then the cost of trying every empty square for a win, and of a whole computer move
+bool benchLines(const vector<Board>& positions) {
+    vector<vector<char> > bookBoards;
+    vector<Board> maskBoards;
+    vector<LineBoard> lineBoards;
+    for (size_t p = 0; p < positions.size(); ++p) {
+        Board board = positions[p];
+        LineBoard lines(board);
+        bool isRight = (lines.Winner() == board.Winner()) &&
+                       (lines.GetNumEmpty() == __builtin_popcount(board.GetEmpty()));
+        for (int move = 0; move < NUM_SQUARES && board.Winner() == NO_ONE; ++move) {
+            if (!lines.isLegal(move)) {
+                continue;
+            }
+            for (int piece = 0; piece < 2; ++piece) {
+                board.Place(move, piece ? O : X);
+                lines.Place(move, piece ? O : X);
+                isRight = isRight && (lines.Winner() == board.Winner());
+                board.Remove(move);
+                lines.Remove(move);
+                isRight = isRight && (lines.Winner() == board.Winner());
+            }
+        }
+        for (int square = 0; square < NUM_SQUARES; ++square) {
+            isRight = isRight && (lines.GetSquare(square) == board.GetSquare(square));
+        }
+        if (board.Winner() == NO_ONE) {
+            isRight = isRight && (heuristicMove(lines, sideToMove(board)) == bookMove(board, sideToMove(board)));
+            vector<char> squares(NUM_SQUARES);
+            for (int square = 0; square < NUM_SQUARES; ++square) {
+                squares[square] = board.GetSquare(square);
+            }
+            bookBoards.push_back(squares);
+            maskBoards.push_back(board);
+            lineBoards.push_back(lines);
+        }
+        if (!isRight) {
+            cout << "lines: position " << p << " doesn't match the bitmask board\n";
+            return false;
+        }
+    }
+    cout << "\nlines: the line counts match the bitmask board in every position and move, and the book's\n";
+    cout << "       computerMove on a LineBoard makes the same move in all " << lineBoards.size() << " positions in play\n";
+
+    //every empty square tried for the side to move, then a whole move, on each kind of board
+    const int PASSES = 200;
+    long long probes = 0;
+    long long wins[3] = {0, 0, 0};
+    double seconds[3];
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < bookBoards.size(); ++p) {
+            vector<char>& board = bookBoards[p];
+            char turn = lineBoards[p].GetNumEmpty() % 2 ? X : O;
+            for (int move = 0; move < NUM_SQUARES; ++move) {
+                if (board[move] == EMPTY) {
+                    board[move] = turn;
+                    wins[0] += (bookWinner(board) == turn);
+                    board[move] = EMPTY;
+                    ++probes;
+                }
+            }
+        }
+    }
+    seconds[0] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < lineBoards.size(); ++p) {
+            Board& board = maskBoards[p];
+            char turn = lineBoards[p].GetNumEmpty() % 2 ? X : O;
+            for (int move = 0; move < NUM_SQUARES; ++move) {
+                if (board.isLegal(move)) {
+                    board.Place(move, turn);
+                    wins[1] += (board.Winner() == turn);
+                    board.Remove(move);
+                }
+            }
+        }
+    }
+    seconds[1] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < lineBoards.size(); ++p) {
+            LineBoard& board = lineBoards[p];
+            char turn = board.GetNumEmpty() % 2 ? X : O;
+            for (int move = 0; move < NUM_SQUARES; ++move) {
+                if (board.isLegal(move)) {
+                    board.Place(move, turn);
+                    wins[2] += (board.Winner() == turn);
+                    board.Remove(move);
+                }
+            }
+        }
+    }
+    seconds[2] = secondsSince(start);
+    const char* NAMES[] = {"book (vector<char>)", "bitmask board      ", "line counts        "};
+    for (int b = 0; b < 3; ++b) {
+        cout << "       try a square, " << NAMES[b] << ": " << 1e9 * seconds[b] / probes << " ns\n";
+    }
+
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < bookBoards.size(); ++p) {
+            checksum += bookComputerMove(bookBoards[p], lineBoards[p].GetNumEmpty() % 2 ? X : O);
+        }
+    }
+    double bookSeconds = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < lineBoards.size(); ++p) {
+            checksum -= heuristicMove(lineBoards[p], lineBoards[p].GetNumEmpty() % 2 ? X : O);
+        }
+    }
+    double lineSeconds = secondsSince(start);
+    double moves = static_cast<double>(PASSES) * lineBoards.size();
+    cout << "       computerMove, book: " << 1e9 * bookSeconds / moves << " ns, line counts: ";
+    cout << 1e9 * lineSeconds / moves << " ns\n";
+    if (wins[1] != wins[0] || wins[2] != wins[0] || checksum != 0) {
+        cout << "lines: the timed runs disagree\n";
+        return false;
+    }
+    return true;
+}
+
+//every symmetry moves the squares to different squares, Unmap undoes Map, no two symmetries are
+//the same, and for masks, MapMask moves each bit where Map moves its square
+template <int SIDE>
+bool checkSymmetries() {
+    MaskSymmetries<SIDE> masks;
+    const Symmetries<SIDE>& squares = masks.GetSquares();
+    const int AREA = SIDE * SIDE;
+    set<vector<int> > seen;
+    bool isRight = true;
+    for (int symmetry = 0; symmetry < Symmetries<SIDE>::NUM_SYMMETRIES; ++symmetry) {
+        vector<int> mapped;
+        unsigned int covered = 0;
+        for (int square = 0; square < AREA; ++square) {
+            mapped.push_back(squares.Map(symmetry, square));
+            covered |= 1u << squares.Map(symmetry, square);
+            isRight = isRight && (squares.Unmap(symmetry, squares.Map(symmetry, square)) == square);
+            isRight = isRight && (masks.MapMask(symmetry, 1u << square) == 1u << squares.Map(symmetry, square));
+        }
+        isRight = isRight && (covered == ((AREA == 32) ? ~0u : (1u << AREA) - 1)) && seen.insert(mapped).second;
+    }
+    return isRight;
+}
+
+//the symmetry tables on a few board sizes, then every reachable position's eight turns and flips
+//have the same canonical form, how many positions are left once they're shared, and the cost of
+//finding a canonical form
+bool benchSymmetry(const vector<Board>& positions) {
+    if (!checkSymmetries<2>() || !checkSymmetries<3>() || !checkSymmetries<4>() || !checkSymmetries<5>()) {
+        cout << "symmetry: the tables aren't eight different symmetries\n";
+        return false;
+    }
+    set<unsigned long long> canonical;
+    for (size_t p = 0; p < positions.size(); ++p) {
+        unsigned int x = positions[p].GetMask(X);
+        unsigned int o = positions[p].GetMask(O);
+        int symmetry;
+        unsigned long long key = SYMMETRIES.Canonical(x, o, symmetry);
+        if (SYMMETRIES.MapMask(symmetry, x) != (key & ALL_SQUARES)) {
+            cout << "symmetry: position " << p << "'s symmetry doesn't give its canonical form\n";
+            return false;
+        }
+        for (int s = 0; s < Symmetries<3>::NUM_SYMMETRIES; ++s) {
+            int other;
+            if (SYMMETRIES.Canonical(SYMMETRIES.MapMask(s, x), SYMMETRIES.MapMask(s, o), other) != key) {
+                cout << "symmetry: position " << p << " and its symmetry " << s << " aren't the same\n";
+                return false;
+            }
+        }
+        canonical.insert(key);
+    }
+    const int PASSES = 200;
+    unsigned long long checksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < positions.size(); ++p) {
+            int symmetry;
+            checksum += SYMMETRIES.Canonical(positions[p].GetMask(X), positions[p].GetMask(O), symmetry) + symmetry;
+        }
+    }
+    double seconds = secondsSince(start);
+    cout << "\nsymmetry: the tables check out on 2x2, 3x3, 4x4 and 5x5 boards, and the " << positions.size();
+    cout << " reachable positions have " << canonical.size() << " canonical forms\n";
+    cout << "          canonical form: " << 1e9 * seconds / (static_cast<double>(PASSES) * positions.size());
+    cout << " ns (checksum " << checksum << ")\n";
+    return true;
+}
+
+//the engine's score and move against plain minimax in every position, its games against every
+//line of play compared with the book's heuristic, then how long a search takes
+bool benchSearch(const vector<Board>& positions) {
+    Engine engine;
+    int numSearched = 0;
+    for (size_t p = 0; p < positions.size(); ++p) {
+        Board board = positions[p];
+        if (board.Winner() != NO_ONE) {
+            continue;
+        }
+        char turn = sideToMove(board);
+        SearchResult result = engine.Search(board, turn);
+        int expected = minimax(board, turn);
+        bool isRight = (result.score == expected) && board.isLegal(result.move);
+        if (isRight) {
+            board.Place(result.move, turn);
+            isRight = (-minimax(board, (turn == X) ? O : X) == expected);
+        }
+        if (!isRight) {
+            cout << "search: position " << p << " scores " << result.score << ", minimax " << expected << "\n";
+            return false;
+        }
+        ++numSearched;
+    }
+    cout << "\nsearch: score and move match minimax in all " << numSearched << " positions still in play\n";
+
+    const char* NAMES[] = {"engine", "book  "};
+    int (*CHOOSE[])(const Board&, char) = {bestMove, bookMove};
+    for (int c = 0; c < 2; ++c) {
+        long long games = 0;
+        long long losses = 0;
+        Board empty;
+        playEveryLine(empty, X, X, CHOOSE[c], games, losses);
+        playEveryLine(empty, X, O, CHOOSE[c], games, losses);
+        cout << "        " << NAMES[c] << ": lost " << losses << " of the " << games;
+        cout << " games every line of the opponent's play gives\n";
+        if (c == 0 && losses != 0) {
+            return false;
+        }
+    }
+
+    //every position searched from scratch, then with the table kept from the positions before
+    for (int isWarm = 0; isWarm < 2; ++isWarm) {
+        long long nodes = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t p = 0; p < positions.size(); ++p) {
+            if (positions[p].Winner() != NO_ONE) {
+                continue;
+            }
+            if (!isWarm) {
+                engine.ClearTable();
+            }
+            nodes += engine.Search(positions[p], sideToMove(positions[p])).nodes;
+        }
+        double seconds = secondsSince(start);
+        cout << "        " << (isWarm ? "kept table " : "empty table") << ": " << 1e6 * seconds / numSearched;
+        cout << " us/move, " << static_cast<double>(nodes) / numSearched << " nodes/move\n";
+    }
+    Board empty;
+    engine.ClearTable();
+    SearchResult first = engine.Search(empty, X);
+    cout << "        first move from scratch: " << first.nodes << " nodes\n";
+    return true;
+}
+
+//the compiled table against plain minimax in every legal position: the side to move has made as
+//many moves as the other, or X one more, and only the side that moved last can have a line. then
+//the cost of a lookup against a search with a kept table
+bool benchEndgame(const vector<Board>& positions) {
+    int numLegal = 0;
+    for (int index = 0; index < NUM_POSITIONS; ++index) {
+        Board board;
+        int digits = index;
+        for (int square = 0; square < NUM_SQUARES; ++square) {
+            if (digits % 3 != 0) {
+                board.Place(square, (digits % 3 == 1) ? X : O);
+            }
+            digits /= 3;
+        }
+        int numX = __builtin_popcount(board.GetMask(X));
+        int numO = __builtin_popcount(board.GetMask(O));
+        char turn = sideToMove(board);
+        char other = (turn == X) ? O : X;
+        if ((numX != numO && numX != numO + 1) || WIN_TABLE.isWin[board.GetMask(turn)]) {
+            continue;
+        }
+        ++numLegal;
+        int move = ENDGAME_TABLE.GetMove(board);
+        int expected = minimax(board, turn);
+        bool isRight = (ENDGAME_TABLE.GetIndex(board) == index) && (ENDGAME_TABLE.GetScore(board) == expected);
+        if (board.Winner() != NO_ONE) {
+            isRight = isRight && (move == EndgameTable::NO_MOVE);
+        }
+        else if (isRight && board.isLegal(move)) {
+            board.Place(move, turn);
+            isRight = (-minimax(board, other) == expected);
+        }
+        else {
+            isRight = false;
+        }
+        if (!isRight) {
+            cout << "endgame: position " << index << " doesn't match minimax\n";
+            return false;
+        }
+    }
+    cout << "\nendgame: score and move match minimax in all " << numLegal << " legal positions; ";
+    cout << "sizeof(EndgameTable) = " << sizeof(EndgameTable) << "\n";
+
+    vector<Board> inPlay;
+    for (size_t p = 0; p < positions.size(); ++p) {
+        if (positions[p].Winner() == NO_ONE) {
+            inPlay.push_back(positions[p]);
+        }
+    }
+    const int PASSES = 200;
+    long long checksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < inPlay.size(); ++p) {
+            checksum += ENDGAME_TABLE.GetMove(inPlay[p]);
+        }
+    }
+    double tableSeconds = secondsSince(start);
+    Engine engine;
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t p = 0; p < inPlay.size(); ++p) {
+            checksum -= engine.BestMove(inPlay[p], sideToMove(inPlay[p]));
+        }
+    }
+    double searchSeconds = secondsSince(start);
+    double calls = static_cast<double>(PASSES) * inPlay.size();
+    cout << "         table lookup: " << 1e9 * tableSeconds / calls << " ns/move, search with a kept table: ";
+    cout << 1e9 * searchSeconds / calls << " ns/move (checksum " << checksum << ")\n";
+    return true;
+}
+
+//walks every game on both boards at once, placing and then removing each move, and checks the
+//m,n,k board's winner against the bitmask board's at every step
+bool sameWinners(Board& board, MnkBoard& mnk, char turn, long long& games) {
+    if (board.Winner() != mnk.Winner()) {
+        return false;
+    }
+    if (board.Winner() != NO_ONE) {
+        ++games;
+        return true;
+    }
+    for (int move = 0; move < NUM_SQUARES; ++move) {
+        if (board.isLegal(move) != mnk.isLegal(move)) {
+            return false;
+        }
+        if (board.isLegal(move)) {
+            board.Place(move, turn);
+            mnk.Place(move, turn);
+            bool isSame = sameWinners(board, mnk, (turn == X) ? O : X, games);
+            board.Remove(move);
+            mnk.Remove(move);
+            if (!isSame) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//the m,n,k board's winner against the bitmask board's in every game of Tic-Tac-Toe, the speed of
+//random playouts and of whole searches on Tic-Tac-Toe and Gomoku boards, then Monte Carlo games
+//against perfect play
+bool benchMcts() {
+    Board board;
+    MnkBoard mnk;
+    long long games = 0;
+    if (!sameWinners(board, mnk, X, games) || mnk.GetNumEmpty() != NUM_SQUARES) {
+        cout << "\nmcts: the m,n,k board's winner doesn't match the bitmask board's\n";
+        return false;
+    }
+    cout << "\nmcts: the m,n,k board's winner matches in all " << games << " games of Tic-Tac-Toe\n";
+
+    const int SIZES[][3] = {{3, 3, 3}, {15, 15, 5}};
+    const long long PLAYOUTS = 200000;
+    for (int s = 0; s < 2; ++s) {
+        MnkBoard empty(SIZES[s][0], SIZES[s][1], SIZES[s][2]);
+        Mcts mcts(1);
+        long long moves = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long long p = 0; p < PLAYOUTS; ++p) {
+            MnkBoard game = empty;
+            mcts.Playout(game, X);
+            moves += game.GetNumPlaced();
+        }
+        double playoutSeconds = secondsSince(start);
+        start = chrono::steady_clock::now();
+        MctsResult result = mcts.Search(empty, X, PLAYOUTS);
+        double searchSeconds = secondsSince(start);
+        cout << "      " << SIZES[s][0] << "," << SIZES[s][1] << "," << SIZES[s][2] << ": ";
+        cout << PLAYOUTS / playoutSeconds << " random playouts/s (" << static_cast<double>(moves) / PLAYOUTS;
+        cout << " moves each), searching " << result.playouts / searchSeconds << " playouts/s, ";
+        cout << result.nodes << " nodes, opening " << result.move << "\n";
+    }
+
+    //Monte Carlo as X and as O against the endgame table, each game seeded differently
+    const int GAMES = 100;
+    const long long MOVE_PLAYOUTS = 5000;
+    int losses = 0;
+    int draws = 0;
+    for (int g = 0; g < 2 * GAMES; ++g) {
+        char computer = (g < GAMES) ? X : O;
+        Mcts mcts(g + 1);
+        Board perfect;
+        MnkBoard game;
+        char turn = X;
+        while (perfect.Winner() == NO_ONE) {
+            int move = (turn == computer) ? mcts.BestMove(game, turn, MOVE_PLAYOUTS) : ENDGAME_TABLE.GetMove(perfect);
+            perfect.Place(move, turn);
+            game.Place(move, turn);
+            turn = (turn == X) ? O : X;
+        }
+        losses += (perfect.Winner() != computer && perfect.Winner() != TIE) ? 1 : 0;
+        draws += (perfect.Winner() == TIE) ? 1 : 0;
+    }
+    cout << "      " << MOVE_PLAYOUTS << " playouts a move against perfect play: drew " << draws << " and lost ";
+    cout << losses << " of " << 2 * GAMES << " games\n";
+    return true;
+}
+
+//a stream buffer that throws away everything written to it, so prompts are formatted in full
+//without anything to show them
+class Discard : public streambuf {
+    protected:
+        virtual int overflow(int c) {
+            return c;
+        }
+};
+
+//the prompt the games' askNumber writes, with the question as a const string& as they used to
+//take it, so a string literal builds a temporary string
+void stringPrompt(ostream& out, const string& question, int high, int low) {
+    out << question << " (" << low << " - " << high << " ): ";
+}
+
+//the same prompt with the question as the games take it now, read straight from the literal
+void prompt(ostream& out, const char* question, int high, int low) {
+    out << question << " (" << low << " - " << high << " ): ";
+}
+
+//the heap allocations each way of choosing the computer's move makes, in every position still in
+//play, and those asking the human for theirs makes; the book's computerMove copies its
+//vector<char> board every call and a const string& prompt builds its literal into a string, and
+//everything else must make none
+bool benchAllocations(const vector<Board>& positions) {
+    vector<Board> inPlay;
+    vector<vector<char> > bookBoards;
+    vector<LineBoard> lineBoards;
+    for (size_t p = 0; p < positions.size(); ++p) {
+        if (positions[p].Winner() == NO_ONE) {
+            inPlay.push_back(positions[p]);
+            vector<char> squares(NUM_SQUARES);
+            for (int square = 0; square < NUM_SQUARES; ++square) {
+                squares[square] = positions[p].GetSquare(square);
+            }
+            bookBoards.push_back(squares);
+            lineBoards.push_back(LineBoard(positions[p]));
+        }
+    }
+    //everything that needs the heap is made before counting starts
+    Engine engine;
+    Mcts mcts(1, 1 << 16);
+    const int NUM_PLAYERS = 5;
+    const char* NAMES[NUM_PLAYERS] = {"random", "heuristic", "perfect", "engine", "mcts"};
+    Strategy* players[NUM_PLAYERS];
+    for (int s = 0; s < NUM_PLAYERS; ++s) {
+        players[s] = makeStrategy(NAMES[s], 100);
+        players[s]->NewGame(s);
+    }
+    MnkBoard gomoku(15, 15, 5);
+    gomoku.Place(112, X);
+    Discard discard;
+    ostream nowhere(&discard);
+
+    const int NUM_WAYS = 9 + NUM_PLAYERS;
+    long long counts[NUM_WAYS];
+    long long checksum = 0;
+    for (int way = 0; way < NUM_WAYS; ++way) {
+        long long before = g_Allocations;
+        for (size_t p = 0; p < inPlay.size(); ++p) {
+            char turn = sideToMove(inPlay[p]);
+            switch (way) {
+            case 0:
+                checksum += bookComputerMove(bookBoards[p], turn);
+                break;
+            case 1:
+                checksum += ENDGAME_TABLE.GetMove(inPlay[p]);
+                break;
+            case 2:
+                checksum += heuristicMove(lineBoards[p], turn);
+                break;
+            case 3:
+                checksum += engine.BestMove(inPlay[p], turn);
+                break;
+            case 4:
+                checksum += bestMove(bookBoards[p], turn);
+                break;
+            case 5:
+                if (p % 10 == 0) {
+                    MnkBoard board;
+                    for (int square = 0; square < NUM_SQUARES; ++square) {
+                        if (inPlay[p].GetSquare(square) != EMPTY) {
+                            board.Place(square, inPlay[p].GetSquare(square));
+                        }
+                    }
+                    checksum += mcts.BestMove(board, turn, 100);
+                }
+                break;
+            case 6:
+                if (p % 100 == 0) {
+                    checksum += mcts.BestMove(gomoku, O, 1000);
+                }
+                break;
+            case 7:
+                stringPrompt(nowhere, "Where will you move?", NUM_SQUARES - 1, 0);
+                break;
+            case 8:
+                prompt(nowhere, "Where will you move?", NUM_SQUARES - 1, 0);
+                break;
+            default:
+                checksum += players[way - 9]->Move(inPlay[p], turn);
+                break;
+            }
+        }
+        counts[way] = g_Allocations - before;
+    }
+    for (int s = 0; s < NUM_PLAYERS; ++s) {
+        delete players[s];
+    }
+
+    cout << "\nallocations: the book's computerMove makes " << static_cast<double>(counts[0]) / inPlay.size();
+    cout << " a move (checksum " << checksum << ")\n";
+    cout << "             a const string& prompt makes " << static_cast<double>(counts[7]) / inPlay.size();
+    cout << " a prompt\n";
+    const char* WAYS[9] = {"", "endgame table", "heuristicMove", "Engine", "bestMove(vector<char>)", "Mcts 3,3,3",
+                           "Mcts 15,15,5", "", "const char* prompt"};
+    bool isNone = true;
+    for (int way = 1; way < NUM_WAYS; ++way) {
+        if (way == 7) {
+            continue;
+        }
+        cout << "             " << ((way < 9) ? WAYS[way] : NAMES[way - 9]) << ((way < 9) ? "" : " player") << ": ";
+        cout << counts[way] << " allocations in all\n";
+        isNone = isNone && (counts[way] == 0);
+    }
+    if (!isNone) {
+        cout << "allocations: a computer turn or a prompt allocated\n";
+    }
+    return isNone;
+}
@@ -0,0 +1,135 @@
+//TicTacToe Tournament
+//Plays every computer player against every other, and itself, across all cores, and reports a
+//win/draw/loss table and how fast each player moves
+//usage: tictactoeTournament [-n games] [-p random,heuristic,perfect,engine,mcts] [-t threads]
+//                           [--opening moves] [--playouts playouts] [--seed seed]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tournament.h"
+
+using namespace std;
+
+vector<string> splitNames(const string& list);
+void printResults(const vector<string>& names, const TournamentStats& stats, double seconds);
+void usage();
+
+int main(int argc, char* argv[]) {
+    TournamentConfig config;
+    string playerList = "random,heuristic,perfect,engine,mcts";
+    int numThreads = thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (flag == "-n") {
+            config.gamesPerPairing = atoll(value);
+        }
+        else if (flag == "-p") {
+            playerList = value;
+        }
+        else if (flag == "-t") {
+            numThreads = atoi(value);
+        }
+        else if (flag == "--opening") {
+            config.openingMoves = atoi(value);
+        }
+        else if (flag == "--playouts") {
+            config.playouts = atoll(value);
+        }
+        else if (flag == "--seed") {
+            config.seed = strtoull(value, 0, 10);
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    vector<string> names = splitNames(playerList);
+    bool isKnown = !names.empty();
+    for (size_t p = 0; p < names.size(); ++p) {
+        Strategy* pPlayer = makeStrategy(names[p], config.playouts);
+        isKnown = isKnown && (pPlayer != 0);
+        delete pPlayer;
+    }
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    if (!isKnown || config.gamesPerPairing < 1 || config.openingMoves < 0 || config.playouts < 1) {
+        usage();
+        return 1;
+    }
+
+    cout << names.size() << " players, " << config.gamesPerPairing << " games a pairing each way round, ";
+    cout << config.openingMoves << " random opening move" << (config.openingMoves == 1 ? "" : "s") << ", seed ";
+    cout << config.seed << ", " << numThreads << " thread" << (numThreads == 1 ? "" : "s") << "\n\n";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    TournamentStats stats = RunTournament(names, config, numThreads);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    printResults(names, stats, elapsed.count());
+    return 0;
+}
+
+vector<string> splitNames(const string& list) {
+    vector<string> names;
+    stringstream stream(list);
+    string name;
+    while (getline(stream, name, ',')) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+//each row player's wins, draws and losses against each column player, playing X and O equally,
+//then each player's speed. a player's speed comes from its games against itself, where every move
+//is its own, timed as a whole and summed over the threads, so its moves and games a second are
+//for one core and include setting up each game
+void printResults(const vector<string>& names, const TournamentStats& stats, double seconds) {
+    const int WIDTH = 22;
+    int numPlayers = static_cast<int>(names.size());
+    cout << "wins-draws-losses of the row player against the column player\n";
+    cout << setw(10) << "";
+    for (int b = 0; b < numPlayers; ++b) {
+        cout << setw(WIDTH) << names[b];
+    }
+    cout << "\n";
+    for (int a = 0; a < numPlayers; ++a) {
+        cout << setw(10) << left << names[a] << right;
+        for (int b = 0; b < numPlayers; ++b) {
+            stringstream cell;
+            cell << stats.GetWins(a, b) << "-" << stats.GetDraws(a, b) << "-" << stats.GetLosses(a, b);
+            cout << setw(WIDTH) << cell.str();
+        }
+        cout << "\n";
+    }
+
+    cout << "\n" << setw(10) << left << "player" << right << setw(14) << "moves" << setw(16) << "moves/s";
+    cout << setw(16) << "games/s" << setw(10) << "forfeits" << "\n";
+    for (int p = 0; p < numPlayers; ++p) {
+        double playerSeconds = (stats.seconds[p] > 0.0) ? stats.seconds[p] : 1e-9;
+        cout << setw(10) << left << names[p] << right << setw(14) << stats.moves[p];
+        cout << setw(16) << static_cast<long long>(stats.selfMoves[p] / playerSeconds);
+        cout << setw(16) << static_cast<long long>(stats.selfGames[p] / playerSeconds);
+        cout << setw(10) << stats.forfeits[p] << "\n";
+    }
+    long long totalGames = stats.numGames;
+    cout << "\n" << totalGames << " games in " << seconds << " s, " << static_cast<long long>(totalGames / seconds);
+    cout << " games/s\n";
+}
+
+void usage() {
+    cerr << "usage: tictactoeTournament [-n games] [-p random,heuristic,perfect,engine,mcts] [-t threads]\n";
+    cerr << "                           [--opening moves] [--playouts playouts] [--seed seed]\n";
+}
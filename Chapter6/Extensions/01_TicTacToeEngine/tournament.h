@@ -0,0 +1,360 @@
+//Tournament
+//Plays Tic-Tac-Toe computer players against each other headlessly, across threads, and counts
+//their wins, draws and losses and how long they take to move
+
+#ifndef TICTACTOE_TOURNAMENT_H
+#define TICTACTOE_TOURNAMENT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../Common/rng.h"
+#include "board.h"
+#include "endgame.h"
+#include "lineBoard.h"
+#include "mcts.h"
+#include "mnkBoard.h"
+#include "search.h"
+
+//a way of choosing moves. each thread makes its own players, so a player's state is only ever
+//used by one thread
+class Strategy {
+    public:
+        virtual ~Strategy();
+        //called before every game with a seed of the game's own, so a player that uses randomness
+        //makes the same moves in the same game however the games are shared between threads
+        virtual void NewGame(std::uint64_t seed);
+        //the square to take for piece; the game isn't over
+        virtual int Move(const Board& board, char piece) = 0;
+};
+
+inline Strategy::~Strategy() {}
+
+inline void Strategy::NewGame(std::uint64_t) {}
+
+//any empty square, all equally likely
+class RandomStrategy : public Strategy {
+    public:
+        virtual void NewGame(std::uint64_t seed);
+        virtual int Move(const Board& board, char piece);
+    private:
+        Rng m_Rng;
+};
+
+inline void RandomStrategy::NewGame(std::uint64_t seed) {
+    m_Rng.Seed(seed);
+}
+
+inline int RandomStrategy::Move(const Board& board, char) {
+    unsigned int empty = board.GetEmpty();
+    //the nth set bit of the empty squares
+    for (int skip = static_cast<int>(m_Rng.Below(__builtin_popcount(empty))); skip > 0; --skip) {
+        empty &= empty - 1;
+    }
+    return __builtin_ctz(empty);
+}
+
+//the book's computerMove: win, block, or the best open square
+class HeuristicStrategy : public Strategy {
+    public:
+        virtual int Move(const Board& board, char piece);
+};
+
+inline int HeuristicStrategy::Move(const Board& board, char piece) {
+    LineBoard lines(board);
+    return heuristicMove(lines, piece);
+}
+
+//a best move from the endgame table, chosen at random when several are equally good, so perfect
+//players still play a variety of games
+class PerfectStrategy : public Strategy {
+    public:
+        virtual void NewGame(std::uint64_t seed);
+        virtual int Move(const Board& board, char piece);
+    private:
+        Rng m_Rng;
+};
+
+inline void PerfectStrategy::NewGame(std::uint64_t seed) {
+    m_Rng.Seed(seed);
+}
+
+inline int PerfectStrategy::Move(const Board& board, char piece) {
+    int best = -NUM_SQUARES - 1;
+    int moves[NUM_SQUARES];
+    int numMoves = 0;
+    Board next = board;
+    for (int move = 0; move < NUM_SQUARES; ++move) {
+        if (!next.isLegal(move)) {
+            continue;
+        }
+        next.Place(move, piece);
+        int score = -ENDGAME_TABLE.GetScore(next);
+        next.Remove(move);
+        if (score > best) {
+            best = score;
+            numMoves = 0;
+        }
+        if (score == best) {
+            moves[numMoves++] = move;
+        }
+    }
+    return moves[m_Rng.Below(numMoves)];
+}
+
+//the negamax Engine, its table cleared before each game so its moves don't depend on which games
+//its thread played before
+class EngineStrategy : public Strategy {
+    public:
+        virtual void NewGame(std::uint64_t seed);
+        virtual int Move(const Board& board, char piece);
+    private:
+        Engine m_Engine;
+};
+
+inline void EngineStrategy::NewGame(std::uint64_t) {
+    m_Engine.ClearTable();
+}
+
+inline int EngineStrategy::Move(const Board& board, char piece) {
+    return m_Engine.BestMove(board, piece);
+}
+
+//Monte Carlo tree search with a fixed number of playouts a move
+class MctsStrategy : public Strategy {
+    public:
+        explicit MctsStrategy(long long playouts);
+        virtual void NewGame(std::uint64_t seed);
+        virtual int Move(const Board& board, char piece);
+    private:
+        //a Tic-Tac-Toe tree never needs more than this
+        static const int MAX_NODES = 1 << 16;
+
+        Mcts m_Mcts;
+        long long m_Playouts;
+};
+
+inline MctsStrategy::MctsStrategy(long long playouts): m_Mcts(1, MAX_NODES), m_Playouts(playouts) {}
+
+inline void MctsStrategy::NewGame(std::uint64_t seed) {
+    m_Mcts.Seed(seed);
+}
+
+inline int MctsStrategy::Move(const Board& board, char piece) {
+    MnkBoard mnk;
+    for (int square = 0; square < NUM_SQUARES; ++square) {
+        if (board.GetSquare(square) != EMPTY) {
+            mnk.Place(square, board.GetSquare(square));
+        }
+    }
+    return m_Mcts.BestMove(mnk, piece, m_Playouts);
+}
+
+//a new player of the named strategy, random, heuristic, perfect, engine or mcts, for the caller to
+//delete, or 0 for an unknown name
+inline Strategy* makeStrategy(const std::string& name, long long playouts) {
+    if (name == "random") {
+        return new RandomStrategy();
+    }
+    if (name == "heuristic") {
+        return new HeuristicStrategy();
+    }
+    if (name == "perfect") {
+        return new PerfectStrategy();
+    }
+    if (name == "engine") {
+        return new EngineStrategy();
+    }
+    if (name == "mcts") {
+        return new MctsStrategy(playouts);
+    }
+    return 0;
+}
+
+struct TournamentConfig {
+    //games each ordered pair plays, the first player as X; every pair plays both ways round, and
+    //every player plays itself
+    long long gamesPerPairing;
+    //random moves made for both sides before the players take over, so players that always
+    //choose the same move still play many different games
+    int openingMoves;
+    //for mcts players
+    long long playouts;
+    std::uint64_t seed;
+
+    TournamentConfig();
+};
+
+inline TournamentConfig::TournamentConfig(): gamesPerPairing(1000), openingMoves(1), playouts(1000), seed(1) {}
+
+//the results, for one thread's share of the games or for all of them
+struct TournamentStats {
+    int numPlayers;
+    //player a's wins, draws and losses against player b, as X or as O, at [(a * numPlayers + b) * 3];
+    //a game against itself is counted once, as X's result
+    std::vector<long long> results;
+    //moves each player chose, in all of its games
+    std::vector<long long> moves;
+    //illegal moves each player tried, each losing the game
+    std::vector<long long> forfeits;
+    //each player's games against itself, the moves in them and the time they took. every move in
+    //them is the player's own, so timing the whole run of them with one clock read at each end
+    //times the player alone, without reading the clock around moves far quicker than the clock
+    std::vector<long long> selfGames;
+    std::vector<long long> selfMoves;
+    std::vector<double> seconds;
+    long long numGames;
+
+    TournamentStats(int players = 0);
+    //adds another share's results to these
+    void Merge(const TournamentStats& other);
+    long long GetWins(int player, int against) const;
+    long long GetDraws(int player, int against) const;
+    long long GetLosses(int player, int against) const;
+};
+
+inline TournamentStats::TournamentStats(int players): numPlayers(players), results(3 * players * players, 0),
+    moves(players, 0), forfeits(players, 0), selfGames(players, 0), selfMoves(players, 0), seconds(players, 0.0),
+    numGames(0) {}
+
+inline void TournamentStats::Merge(const TournamentStats& other) {
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        results[i] += other.results[i];
+    }
+    for (int p = 0; p < numPlayers; ++p) {
+        moves[p] += other.moves[p];
+        forfeits[p] += other.forfeits[p];
+        selfGames[p] += other.selfGames[p];
+        selfMoves[p] += other.selfMoves[p];
+        seconds[p] += other.seconds[p];
+    }
+    numGames += other.numGames;
+}
+
+inline long long TournamentStats::GetWins(int player, int against) const {
+    return results[(player * numPlayers + against) * 3];
+}
+
+inline long long TournamentStats::GetDraws(int player, int against) const {
+    return results[(player * numPlayers + against) * 3 + 1];
+}
+
+inline long long TournamentStats::GetLosses(int player, int against) const {
+    return results[(player * numPlayers + against) * 3 + 2];
+}
+
+//plays one game between players x and o, numbered for the stats, and counts it
+inline void playGame(Strategy* pX, Strategy* pO, int x, int o, std::uint64_t seed, int openingMoves,
+                     TournamentStats& stats) {
+    //the opening, and each player, draw from their own random stream of the game's seed
+    Rng opening(seed);
+    pX->NewGame(opening());
+    pO->NewGame(opening());
+
+    Board board;
+    char turn = X;
+    for (int i = 0; i < openingMoves && board.Winner() == NO_ONE; ++i) {
+        unsigned int empty = board.GetEmpty();
+        for (int skip = static_cast<int>(opening.Below(__builtin_popcount(empty))); skip > 0; --skip) {
+            empty &= empty - 1;
+        }
+        board.Place(__builtin_ctz(empty), turn);
+        turn = (turn == X) ? O : X;
+    }
+
+    char winner = board.Winner();
+    while (winner == NO_ONE) {
+        Strategy* pPlayer = (turn == X) ? pX : pO;
+        int player = (turn == X) ? x : o;
+        int move = pPlayer->Move(board, turn);
+        ++stats.moves[player];
+        if (move < 0 || move >= NUM_SQUARES || !board.isLegal(move)) {
+            ++stats.forfeits[player];
+            winner = (turn == X) ? O : X;
+            break;
+        }
+        board.Place(move, turn);
+        winner = board.Winner();
+        turn = (turn == X) ? O : X;
+    }
+
+    int outcome = (winner == TIE) ? 1 : ((winner == X) ? 0 : 2);
+    stats.results[(x * stats.numPlayers + o) * 3 + outcome] += 1;
+    if (o != x) {
+        stats.results[(o * stats.numPlayers + x) * 3 + 2 - outcome] += 1;
+    }
+    ++stats.numGames;
+}
+
+//plays games first to last of the whole tournament on this thread, with its own players. game g
+//is pairing g / gamesPerPairing, and its seed depends only on the tournament's seed and g, so the
+//results are the same however many threads share the games
+inline void runGames(const std::vector<std::string>* pNames, TournamentConfig config, long long first,
+                     long long last, TournamentStats* pStats) {
+    int numPlayers = static_cast<int>(pNames->size());
+    //one set of players for X and one for O, so a player playing itself doesn't share its state
+    std::vector<Strategy*> xPlayers;
+    std::vector<Strategy*> oPlayers;
+    for (int p = 0; p < numPlayers; ++p) {
+        xPlayers.push_back(makeStrategy((*pNames)[p], config.playouts));
+        oPlayers.push_back(makeStrategy((*pNames)[p], config.playouts));
+    }
+    TournamentStats stats(numPlayers);
+    //a pairing's games at a time, so a player's games against itself are timed as one run
+    for (long long game = first; game < last; ) {
+        long long pairing = game / config.gamesPerPairing;
+        long long end = std::min(last, (pairing + 1) * config.gamesPerPairing);
+        int x = static_cast<int>(pairing / numPlayers);
+        int o = static_cast<int>(pairing % numPlayers);
+        long long numGames = end - game;
+        long long movesBefore = stats.moves[x];
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (; game < end; ++game) {
+            playGame(xPlayers[x], oPlayers[o], x, o, config.seed + static_cast<std::uint64_t>(game),
+                     config.openingMoves, stats);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (x == o) {
+            stats.selfGames[x] += numGames;
+            stats.selfMoves[x] += stats.moves[x] - movesBefore;
+            stats.seconds[x] += elapsed.count();
+        }
+    }
+    for (int p = 0; p < numPlayers; ++p) {
+        delete xPlayers[p];
+        delete oPlayers[p];
+    }
+    *pStats = stats;
+}
+
+//every named player against every other and itself, both ways round, split across numThreads
+//threads; the names must all be known to makeStrategy
+inline TournamentStats RunTournament(const std::vector<std::string>& names, const TournamentConfig& config,
+                                     int numThreads) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    int numPlayers = static_cast<int>(names.size());
+    long long total = config.gamesPerPairing * numPlayers * numPlayers;
+    std::vector<TournamentStats> results(numThreads);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        long long first = total * i / numThreads;
+        long long last = total * (i + 1) / numThreads;
+        threads.push_back(std::thread(runGames, &names, config, first, last, &results[i]));
+    }
+
+    TournamentStats stats(numPlayers);
+    for (int i = 0; i < numThreads; ++i) {
+        threads[i].join();
+        stats.Merge(results[i]);
+    }
+    return stats;
+}
+
+#endif
@@ -0,0 +1,37 @@
+//AllocationCounter
+//Replaces the global operator new and delete with versions that count every heap allocation, so a
+//benchmark can check which code allocates and how much
+
+#ifndef COMMON_ALLOCATION_COUNTER_H
+#define COMMON_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//the replacements are definitions, not declarations, so a program includes this header from
+//exactly one source file. the counts are atomic so allocations on any thread are counted
+static std::atomic<long long> g_Allocations(0);
+static std::atomic<long long> g_AllocatedBytes(0);
+
+//kept out of line: if the compiler inlines them into a caller it sees memory from new handed to
+//free, and warns that they don't match, though here they're the same malloc and free
+__attribute__((noinline)) void* operator new(std::size_t size) {
+    ++g_Allocations;
+    g_AllocatedBytes += size;
+    void* p = std::malloc(size);
+    if (p == 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif
@@ -0,0 +1,109 @@
+//Rng
+//A small, fast, seedable random number generator, shared by the Blackjack simulator and the
+//Tic-Tac-Toe engine
+
+#ifndef COMMON_RNG_H
+#define COMMON_RNG_H
+
+#include <cstdint>
+
+//xoshiro256** (Blackman and Vigna): 32 bytes of state against mt19937's 5 KB, a handful of
+//shifts and xors per number, and good enough statistically for any card or board game. It meets
+//the standard UniformRandomBitGenerator requirements, so it can be handed to std::shuffle too.
+//each Deck, simulation thread or game player owns one; it is not safe to share between threads
+class Rng {
+    public:
+        typedef std::uint64_t result_type;
+
+        Rng(std::uint64_t seed = 1);
+        //restarts the sequence; equal seeds give equal sequences
+        void Seed(std::uint64_t seed);
+        //the next 64 random bits
+        result_type operator()();
+        //a uniformly distributed number in [0, n), n must be at least 1
+        std::uint32_t Below(std::uint32_t n);
+        //skips ahead 2^128 numbers; generators seeded alike and jumped a different number of
+        //times give sequences that can't overlap, one per thread
+        void Jump();
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~static_cast<result_type>(0); }
+    private:
+        static std::uint64_t Rotl(std::uint64_t x, int k);
+
+        std::uint64_t m_State[4];
+};
+
+inline Rng::Rng(std::uint64_t seed) {
+    Seed(seed);
+}
+
+inline void Rng::Seed(std::uint64_t seed) {
+    //spread the seed over the whole state with splitmix64, as the xoshiro authors recommend,
+    //so nearby seeds still give unrelated sequences and the state is never all zero
+    for (int i = 0; i < 4; ++i) {
+        seed += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        m_State[i] = z ^ (z >> 31);
+    }
+}
+
+inline std::uint64_t Rng::Rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+inline Rng::result_type Rng::operator()() {
+    std::uint64_t result = Rotl(m_State[1] * 5, 7) * 9;
+    std::uint64_t t = m_State[1] << 17;
+    m_State[2] ^= m_State[0];
+    m_State[3] ^= m_State[1];
+    m_State[1] ^= m_State[2];
+    m_State[0] ^= m_State[3];
+    m_State[2] ^= t;
+    m_State[3] = Rotl(m_State[3], 45);
+    return result;
+}
+
+inline std::uint32_t Rng::Below(std::uint32_t n) {
+    //Lemire's multiply-shift: the high word of a 32x32 bit product is a number in [0, n), and
+    //rejecting the few low words below 2^32 mod n removes the bias without a division per draw.
+    //the top 32 bits of the generator are its best, so those are the ones used
+    std::uint64_t product = ((*this)() >> 32) * n;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < n) {
+        std::uint32_t threshold = (0u - n) % n;
+        while (low < threshold) {
+            product = ((*this)() >> 32) * n;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+inline void Rng::Jump() {
+    const std::uint64_t JUMP[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                  0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    std::uint64_t s0 = 0;
+    std::uint64_t s1 = 0;
+    std::uint64_t s2 = 0;
+    std::uint64_t s3 = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (JUMP[i] & (static_cast<std::uint64_t>(1) << b)) {
+                s0 ^= m_State[0];
+                s1 ^= m_State[1];
+                s2 ^= m_State[2];
+                s3 ^= m_State[3];
+            }
+            (*this)();
+        }
+    }
+    m_State[0] = s0;
+    m_State[1] = s1;
+    m_State[2] = s2;
+    m_State[3] = s3;
+}
+
+#endif